@@ -83,50 +83,6 @@ int comparar_por_energia(const void* a, const void* b) {
     return alim_b->energia_kcal - alim_a->energia_kcal;
 }
 
-int comparar_por_umidade(const void* a, const void* b) {
-    Alimento* alim_a = *(Alimento**)a;
-    Alimento* alim_b = *(Alimento**)b;
-    if (alim_b->umidade > alim_a->umidade) return 1;
-    if (alim_b->umidade < alim_a->umidade) return -1;
-    return 0;
-}
-
-int comparar_por_proteina(const void* a, const void* b) {
-    Alimento* alim_a = *(Alimento**)a;
-    Alimento* alim_b = *(Alimento**)b;
-    if (alim_b->proteina > alim_a->proteina) return 1;
-    if (alim_b->proteina < alim_a->proteina) return -1;
-    return 0;
-}
-
-int comparar_por_carboidrato(const void* a, const void* b) {
-    Alimento* alim_a = *(Alimento**)a;
-    Alimento* alim_b = *(Alimento**)b;
-    if (alim_b->carboidrato > alim_a->carboidrato) return 1;
-    if (alim_b->carboidrato < alim_a->carboidrato) return -1;
-    return 0;
-}
-
-int comparar_por_energia_proteina(const void* a, const void* b) {
-    Alimento* alim_a = *(Alimento**)a;
-    Alimento* alim_b = *(Alimento**)b;
-    double relacao_a = (alim_a->proteina > 0) ? (double)alim_a->energia_kcal / alim_a->proteina : 0;
-    double relacao_b = (alim_b->proteina > 0) ? (double)alim_b->energia_kcal / alim_b->proteina : 0;
-    if (relacao_b > relacao_a) return 1;
-    if (relacao_b < relacao_a) return -1;
-    return 0;
-}
-
-int comparar_por_energia_carboidrato(const void* a, const void* b) {
-    Alimento* alim_a = *(Alimento**)a;
-    Alimento* alim_b = *(Alimento**)b;
-    double relacao_a = (alim_a->carboidrato > 0) ? (double)alim_a->energia_kcal / alim_a->carboidrato : 0;
-    double relacao_b = (alim_b->carboidrato > 0) ? (double)alim_b->energia_kcal / alim_b->carboidrato : 0;
-    if (relacao_b > relacao_a) return 1;
-    if (relacao_b < relacao_a) return -1;
-    return 0;
-}
-
 
 // Partição do Quick Sort: rearranja o array
 int particao(Alimento** arr, int baixo, int alto, int (*comparar)(const void*, const void*)) {
@@ -155,6 +111,103 @@ void quick_sort(Alimento** arr, int baixo, int alto, int (*comparar)(const void*
     }
 }
 
+// --- Seleção dos N melhores com heap limitado ---
+
+// Um candidato no heap: o alimento, o valor da métrica e a ordem em que apareceu (para desempate)
+typedef struct {
+    Alimento* alimento;
+    double valor;
+    int ordem;
+} CandidatoHeap;
+
+// Diz se o candidato 'a' é pior que o 'b': menor valor, ou mesmo valor e apareceu depois
+static bool pior_candidato(const CandidatoHeap* a, const CandidatoHeap* b) {
+    if (a->valor != b->valor) {
+        return a->valor < b->valor;
+    }
+    return a->ordem > b->ordem;
+}
+
+// Desce o candidato da posição 'i' até o lugar certo (o pior fica sempre na raiz)
+static void descer_no_heap(CandidatoHeap* heap, int tamanho, int i) {
+    while (1) {
+        int menor = i;
+        int esquerda = 2 * i + 1;
+        int direita = 2 * i + 2;
+        if (esquerda < tamanho && pior_candidato(&heap[esquerda], &heap[menor])) menor = esquerda;
+        if (direita < tamanho && pior_candidato(&heap[direita], &heap[menor])) menor = direita;
+        if (menor == i) {
+            return;
+        }
+        CandidatoHeap temp = heap[i];
+        heap[i] = heap[menor];
+        heap[menor] = temp;
+        i = menor;
+    }
+}
+
+// Sobe o candidato da posição 'i' enquanto ele for pior que o pai
+static void subir_no_heap(CandidatoHeap* heap, int i) {
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (!pior_candidato(&heap[i], &heap[pai])) {
+            return;
+        }
+        CandidatoHeap temp = heap[i];
+        heap[i] = heap[pai];
+        heap[pai] = temp;
+        i = pai;
+    }
+}
+
+// Seleciona os N alimentos de maior valor segundo 'obter_valor' (qualquer métrica, inclusive as
+// razões), considerando só os da categoria dada (NULL = todos). Em vez de ordenar tudo, mantém um
+// heap com os N melhores vistos até agora, cujo pior fica na raiz: cada alimento custa O(log N).
+// Grava os escolhidos em 'saida' (espaço para N), do melhor para o pior, e retorna quantos são.
+// Empates ficam na ordem em que os alimentos aparecem na lista.
+int selecionar_n_melhores(Alimento** alimentos, int total, const char* categoria, int n,
+                          double (*obter_valor)(Alimento*), Alimento** saida) {
+    if (n <= 0) {
+        return 0;
+    }
+
+    CandidatoHeap* heap = (CandidatoHeap*)malloc(n * sizeof(CandidatoHeap));
+    if (heap == NULL) {
+        printf("Erro ao alocar memoria para a selecao.\n");
+        return 0;
+    }
+
+    int tamanho = 0;
+    for (int i = 0; i < total; i++) {
+        if (categoria != NULL && strcmp(alimentos[i]->categoria, categoria) != 0) {
+            continue;
+        }
+        CandidatoHeap candidato = { alimentos[i], obter_valor(alimentos[i]), i };
+        if (tamanho < n) {
+            // Ainda cabe: entra no fim e sobe até o lugar certo
+            heap[tamanho] = candidato;
+            subir_no_heap(heap, tamanho);
+            tamanho++;
+        } else if (pior_candidato(&heap[0], &candidato)) {
+            // Heap cheio: só entra se for melhor que o pior guardado, que sai
+            heap[0] = candidato;
+            descer_no_heap(heap, tamanho, 0);
+        }
+    }
+
+    // Esvazia o heap: o pior sai primeiro, então preenche a saída de trás para frente
+    int selecionados = tamanho;
+    while (tamanho > 0) {
+        saida[tamanho - 1] = heap[0].alimento;
+        tamanho--;
+        heap[0] = heap[tamanho];
+        descer_no_heap(heap, tamanho, 0);
+    }
+
+    free(heap);
+    return selecionados;
+}
+
 // ===================================================================================
 // FUNÇÃO PARA EXIBIR O MENU DE OPÇÕES DO USUÁRIO
 // ===================================================================================
@@ -346,7 +399,6 @@ void listar_alimentos_por_categoria_energia(Alimento** alimentos, int total) {
 // FUNÇÃO GENÉRICA PARA LISTAR OS 'N' MELHORES (OPÇÕES 'd' a 'i')
 // ===================================================================================
 void listar_n_melhores(Alimento** alimentos, int total, const char* titulo_opcao, const char* titulo_valor, const char* unidade, 
-                       int (*comparar)(const void*, const void*),
                        double (*obter_valor)(Alimento*)) {
 
     char categoria_escolhida[100];
@@ -359,41 +411,39 @@ void listar_n_melhores(Alimento** alimentos, int total, const char* titulo_opcao
     scanf(" %[^\n]", categoria_escolhida);
 
     printf("> Digite a quantidade de alimentos (N) a serem listados: ");
-    scanf("%d", &n);
+    if (scanf("%d", &n) != 1 || n <= 0) {
+        printf("\nQuantidade invalida.\n");
+        return;
+    }
 
-    // Passo 2: Filtragem dos alimentos
-    Alimento* alimentos_filtrados[100];
-    int total_filtrados = 0;
-    for (int i = 0; i < total; i++) {
-        if (strcmp(alimentos[i]->categoria, categoria_escolhida) == 0) {
-            alimentos_filtrados[total_filtrados++] = alimentos[i];
-        }
+    // Passo 2: Seleção dos N melhores da categoria (heap limitado, sem ordenar a categoria inteira)
+    // Nunca há mais que 'total' alimentos na categoria, então o espaço pode ser limitado a isso.
+    int limite = (n < total) ? n : total;
+    Alimento** melhores = (Alimento**)malloc((limite > 0 ? limite : 1) * sizeof(Alimento*));
+    if (melhores == NULL) {
+        printf("Erro ao alocar memoria para a selecao.\n");
+        return;
     }
+    int total_melhores = selecionar_n_melhores(alimentos, total, categoria_escolhida, limite, obter_valor, melhores);
 
-    if (total_filtrados == 0) {
+    if (total_melhores == 0) {
         printf("\nNenhum alimento encontrado para a categoria \"%s\".\n", categoria_escolhida);
+        free(melhores);
         return;
     }
 
-    // Passo 3: Ordenação com Quick Sort
-    quick_sort(alimentos_filtrados, 0, total_filtrados - 1, comparar);
-
-    // Passo 4: Exibir os resultados
+    // Passo 3: Exibir os resultados (já vêm do melhor para o pior)
     printf("\n--- Top %d Alimentos em '%s' por Maior %s ---\n", n, categoria_escolhida, titulo_opcao);
-    
-    // Limita o 'n' ao número de alimentos encontrados, se necessário
-    if (n > total_filtrados) {
-        n = total_filtrados;
-    }
 
-    for (int i = 0; i < n; i++) {
+    for (int i = 0; i < total_melhores; i++) {
         printf("  %d. %s | %s: %.2f %s\n",
                i + 1,
-               alimentos_filtrados[i]->descricao,
+               melhores[i]->descricao,
                titulo_valor,
-               obter_valor(alimentos_filtrados[i]),
+               obter_valor(melhores[i]),
                unidade);
     }
+    free(melhores);
 }
 
 // Funções para obter os valores específicos para o printf
@@ -410,26 +460,26 @@ double obter_valor_energia_carboidrato(Alimento* a) { return (a->carboidrato > 0
 // ===================================================================================
 
 void listar_n_melhores_umidade(Alimento** alimentos, int total) {
-    listar_n_melhores(alimentos, total, "Umidade", "Umidade", "%", comparar_por_umidade, obter_valor_umidade);
+    listar_n_melhores(alimentos, total, "Umidade", "Umidade", "%", obter_valor_umidade);
 }
 
 void listar_n_melhores_energia(Alimento** alimentos, int total) {
-    listar_n_melhores(alimentos, total, "Energia", "Energia", "Kcal", comparar_por_energia, obter_valor_energia);
+    listar_n_melhores(alimentos, total, "Energia", "Energia", "Kcal", obter_valor_energia);
 }
 
 void listar_n_melhores_proteina(Alimento** alimentos, int total) {
-    listar_n_melhores(alimentos, total, "Proteina", "Proteina", "g", comparar_por_proteina, obter_valor_proteina);
+    listar_n_melhores(alimentos, total, "Proteina", "Proteina", "g", obter_valor_proteina);
 }
 
 void listar_n_melhores_carboidrato(Alimento** alimentos, int total) {
-    listar_n_melhores(alimentos, total, "Carboidrato", "Carboidrato", "g", comparar_por_carboidrato, obter_valor_carboidrato);
+    listar_n_melhores(alimentos, total, "Carboidrato", "Carboidrato", "g", obter_valor_carboidrato);
 }
 
 void listar_n_melhores_energia_proteina(Alimento** alimentos, int total) {
-    listar_n_melhores(alimentos, total, "Relacao Energia/Proteina", "Relacao E/P", "", comparar_por_energia_proteina, obter_valor_energia_proteina);
+    listar_n_melhores(alimentos, total, "Relacao Energia/Proteina", "Relacao E/P", "", obter_valor_energia_proteina);
 }
 
 void listar_n_melhores_energia_carboidrato(Alimento** alimentos, int total) {
-    listar_n_melhores(alimentos, total, "Relacao Energia/Carboidrato", "Relacao E/C", "", comparar_por_energia_carboidrato, obter_valor_energia_carboidrato);
+    listar_n_melhores(alimentos, total, "Relacao Energia/Carboidrato", "Relacao E/C", "", obter_valor_energia_carboidrato);
 }
 
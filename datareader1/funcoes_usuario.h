@@ -35,6 +35,11 @@ void listar_n_melhores_carboidrato(Alimento** alimentos, int total);
 void listar_n_melhores_energia_proteina(Alimento** alimentos, int total);
 void listar_n_melhores_energia_carboidrato(Alimento** alimentos, int total);
 
+// Seleciona os N alimentos de maior valor de uma métrica qualquer (categoria NULL = todas), com heap limitado: O(total log N).
+// Grava em 'saida' do melhor para o pior e retorna quantos foram selecionados.
+int selecionar_n_melhores(Alimento** alimentos, int total, const char* categoria, int n,
+                          double (*obter_valor)(Alimento*), Alimento** saida);
+
 
 #endif // FUNCOES_USUARIO_H
 
@@ -4,9 +4,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <json-c/json.h>
-
-#define MAX_DESCRICAO 100
-#define MAX_CATEGORIA 50
+#include "formato.h"
 
 /* Estrutura para armazenar alimento em memoria (com ponteiros dinamicos) */
 typedef struct {
@@ -19,17 +17,6 @@ typedef struct {
     char* categoria;
 } Alimento;
 
-/* Estrutura para armazenar alimento em arquivo binario (tamanho fixo) */
-typedef struct {
-    int numero;
-    char descricao[MAX_DESCRICAO];
-    double umidade;
-    int energia_kcal;
-    double proteina;
-    double carboidrato;
-    char categoria[MAX_CATEGORIA];
-} AlimentoArquivo;
-
 /* ===================================================================================
    FUNCAO PARA LER OS DADOS DO ARQUIVO .JSON ORIGINAL
    =================================================================================== */
@@ -109,31 +96,35 @@ Alimento** ler_alimentos_do_json(const char* arquivo_json, int* total_alimentos)
    FUNCAO PARA SALVAR OS DADOS EM BINARIO
    =================================================================================== */
 bool salvar_em_binario(Alimento** array_memoria, int total_alimentos, const char* arquivo_bin) {
-    FILE* f_binario = fopen(arquivo_bin, "wb");
-    if (f_binario == NULL) {
-        perror("Nao foi possivel criar o arquivo binario");
+    RegistroAlimento* registros = (RegistroAlimento*)malloc((total_alimentos > 0 ? total_alimentos : 1) * sizeof(RegistroAlimento));
+    if (registros == NULL) {
+        fprintf(stderr, "Falha ao alocar memoria para os registros.\n");
         return false;
     }
 
     printf("Escrevendo dados em '%s'...\n", arquivo_bin);
 
+    /* O formato colunar agrupa os registros por categoria e grava cada
+     * campo numerico em sua propria coluna, com as descricoes em um heap
+     * de textos separado (ver formato.h) */
     for (int i = 0; i < total_alimentos; i++) {
-        AlimentoArquivo temp_bin;
-        memset(&temp_bin, 0, sizeof(AlimentoArquivo));
-
-        temp_bin.numero = array_memoria[i]->numero;
-        temp_bin.umidade = array_memoria[i]->umidade;
-        temp_bin.energia_kcal = array_memoria[i]->energia_kcal;
-        temp_bin.proteina = array_memoria[i]->proteina;
-        temp_bin.carboidrato = array_memoria[i]->carboidrato;
+        registros[i].numero = array_memoria[i]->numero;
+        registros[i].descricao = array_memoria[i]->descricao;
+        registros[i].tamanho_descricao = (uint32_t)strlen(array_memoria[i]->descricao);
+        registros[i].umidade = array_memoria[i]->umidade;
+        registros[i].energia_kcal = array_memoria[i]->energia_kcal;
+        registros[i].proteina = array_memoria[i]->proteina;
+        registros[i].carboidrato = array_memoria[i]->carboidrato;
+        registros[i].categoria = array_memoria[i]->categoria;
+    }
 
-        strncpy(temp_bin.descricao, array_memoria[i]->descricao, MAX_DESCRICAO - 1);
-        strncpy(temp_bin.categoria, array_memoria[i]->categoria, MAX_CATEGORIA - 1);
+    bool sucesso = gravar_arquivo_binario(arquivo_bin, registros, (size_t)total_alimentos);
+    free(registros);
 
-        fwrite(&temp_bin, sizeof(AlimentoArquivo), 1, f_binario);
+    if (!sucesso) {
+        return false;
     }
 
-    fclose(f_binario);
     printf("Arquivo '%s' criado com sucesso.\n", arquivo_bin);
     return true;
 }
@@ -12,9 +12,9 @@ int main() {
     printf("=== PROGRAMA P2 - Sistema de Gerenciamento de Alimentos ===\n\n");
     printf("Carregando dados do arquivo '%s'...\n", arquivo_bin);
 
-    NoCategoria* lista_categorias = carregar_dados_binario(arquivo_bin);
+    BaseDados base;
 
-    if (lista_categorias == NULL) {
+    if (!carregar_dados_binario(arquivo_bin, &base)) {
         fprintf(stderr, "Falha ao carregar dados do arquivo binario.\n");
         fprintf(stderr, "Certifique-se de que o arquivo '%s' existe.\n", arquivo_bin);
         fprintf(stderr, "Execute o programa P1 primeiro para gerar o arquivo.\n");
@@ -30,23 +30,35 @@ int main() {
         opcao = exibir_menu();
 
         if (opcao == 1) {
-            opcao_listar_categorias(lista_categorias);
+            opcao_listar_categorias(&base);
         } else if (opcao == 2) {
-            opcao_listar_alimentos(lista_categorias);
+            opcao_listar_alimentos(&base);
         } else if (opcao == 3) {
-            opcao_listar_por_energia(lista_categorias);
+            opcao_listar_por_energia(&base);
         } else if (opcao == 4) {
-            opcao_listar_por_proteina(lista_categorias);
+            opcao_listar_por_proteina(&base);
         } else if (opcao == 5) {
-            opcao_intervalo_energia(lista_categorias);
+            opcao_intervalo_energia(&base);
         } else if (opcao == 6) {
-            opcao_intervalo_proteina(lista_categorias);
+            opcao_intervalo_proteina(&base);
         } else if (opcao == 7) {
-            lista_categorias = opcao_remover_categoria(lista_categorias, &dados_modificados);
+            opcao_remover_categoria(&base, &dados_modificados);
         } else if (opcao == 8) {
-            opcao_remover_alimento(lista_categorias, &dados_modificados);
-        } else if (opcao == 9) {
+            opcao_remover_alimento(&base, &dados_modificados);
+        } else if (opcao == OPCAO_SAIR) {
             sair = 1;
+        } else if (opcao == 10) {
+            opcao_filtrar_nutrientes(&base);
+        } else if (opcao == 11) {
+            opcao_estatisticas_categorias(&base);
+        } else if (opcao == 12) {
+            opcao_melhores_categoria(&base);
+        } else if (opcao == 13) {
+            opcao_contagens_percentis(&base);
+        } else if (opcao == 14) {
+            opcao_caixa_nutrientes(&base);
+        } else if (opcao == 15) {
+            opcao_similares(&base);
         } else {
             printf("\nOpcao invalida! Tente novamente.\n");
         }
@@ -54,7 +66,7 @@ int main() {
 
     if (dados_modificados) {
         printf("\nDados foram modificados. Salvando arquivo atualizado...\n");
-        if (salvar_dados_binario(lista_categorias, arquivo_bin)) {
+        if (salvar_dados_binario(&base, arquivo_bin)) {
             printf("Arquivo '%s' atualizado com sucesso!\n", arquivo_bin);
         } else {
             fprintf(stderr, "Erro ao salvar o arquivo atualizado.\n");
@@ -62,7 +74,7 @@ int main() {
     }
 
     printf("\nLiberando memoria...\n");
-    liberar_categorias(lista_categorias);
+    liberar_base_dados(&base);
 
     printf("Programa encerrado. Ate logo!\n");
     return 0;
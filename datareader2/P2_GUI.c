@@ -27,8 +27,8 @@
 #include <windows.h>       // API do Windows (WinMain, MessageBox, etc)
 #include <stdio.h>         // printf, sprintf (nao usado em GUI mas incluido por compatibilidade)
 #include "tipos.h"         // Definicoes de estruturas (NoCategoria, NoAlimento, AppData)
-#include "arquivo.h"       // carregar_dados_binario, salvar_dados_binario
-#include "categoria.h"     // liberar_categorias
+#include "arquivo.h"       // carregar_dados_binario, salvar_dados_binario, liberar_base_dados
+#include "categoria.h"     // funcoes de categorias
 #include "gui.h"           // SetAppData, InicializarGUI
 
 /******************************************************************************
@@ -114,20 +114,24 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
     /*** PASSO 4: CARREGAR DADOS DO ARQUIVO BINARIO ***/
 
     /* Chamar funcao que:
-     * 1. Abre dados.bin para leitura
-     * 2. Le estruturas AlimentoArquivo uma a uma
+     * 1. Mapeia dados.bin em memoria (sem ler registro por registro)
+     * 2. Aloca todos os nos de alimento em um unico bloco
      * 3. Cria lista encadeada de categorias (ordenada alfabeticamente)
-     * 4. Para cada categoria, cria:
-     *    - Lista encadeada de alimentos (ordenada alfabeticamente)
+     * 4. Monta a tabela colunar dos alimentos (uma faixa de linhas por
+     *    categoria, ordenada alfabeticamente)
+     * 5. Para cada categoria, cria:
      *    - Arvore binaria indexada por energia
      *    - Arvore binaria indexada por proteina
-     * 5. Retorna ponteiro para primeira categoria ou NULL se falhar
+     * 6. Retorna false se falhar
+     *
+     * As descricoes NAO sao copiadas: cada NoAlimento aponta para o texto
+     * dentro do mapeamento, que fica valido ate liberar_base_dados.
      */
-    NoCategoria* lista_categorias = carregar_dados_binario(arquivo_bin);
+    BaseDados base;
 
     /*** PASSO 5: VERIFICAR SE CARREGAMENTO FOI BEM-SUCEDIDO ***/
 
-    if (lista_categorias == NULL) {
+    if (!carregar_dados_binario(arquivo_bin, &base)) {
         /* Falha ao carregar dados - possiveis causas:
          * - Arquivo dados.bin nao encontrado
          * - Arquivo corrompido
@@ -152,7 +156,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
     /*** PASSO 6: INICIALIZAR ESTRUTURA DE DADOS DA APLICACAO ***/
 
     /* AppData e estrutura que agrupa todos os dados da aplicacao:
-     * - lista_categorias: ponteiro para lista encadeada de categorias
+     * - base: ponteiro para a base carregada (lista e registro de categorias)
      * - hwndMain: handle da janela principal (sera preenchido em gui.c)
      * - hwndListBox: handle da listbox de resultados (sera preenchido em gui.c)
      * - hwndStatus: handle da barra de status (sera preenchido em gui.c)
@@ -163,8 +167,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
     /* {0} e sintaxe C para inicializar todos os campos com 0/NULL/false */
     AppData appData = {0};
 
-    /* Preencher campo lista_categorias com dados carregados */
-    appData.lista_categorias = lista_categorias;
+    /* Apontar para a base carregada: a GUI consulta o registro de
+     * categorias e atualiza a lista diretamente nela */
+    appData.base = &base;
 
     /* Marcar dados como nao modificados inicialmente */
     /* Se usuario remover categoria/alimento, isso mudara para true */
@@ -244,13 +249,13 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
 
         /* Tentar salvar dados */
         /* salvar_dados_binario (definida em arquivo.c) faz:
-         * 1. Percorre lista de categorias
-         * 2. Para cada categoria, percorre lista de alimentos
-         * 3. Converte NoAlimento para AlimentoArquivo (formato fixo)
+         * 1. Percorre as particoes (categorias) da tabela colunar
+         * 2. Para cada particao, pega as linhas nao removidas
+         * 3. Converte cada linha para o registro do arquivo
          * 4. Escreve no arquivo binario
          * 5. Retorna true se sucesso, false se erro
          */
-        if (salvar_dados_binario(lista_categorias, arquivo_bin)) {
+        if (salvar_dados_binario(&base, arquivo_bin)) {
             /* Salvamento bem-sucedido */
             MessageBox(NULL,
                 "Arquivo atualizado com sucesso!",
@@ -275,18 +280,16 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
     /* Antes de encerrar programa, CRUCIAL liberar toda memoria alocada */
     /* para evitar memory leaks (vazamento de memoria) */
 
-    /* liberar_categorias (definida em categoria.c) faz recursivamente:
-     * 1. Para cada categoria:
-     *    a. Libera arvore de energia (chamando liberar_arvore)
-     *    b. Libera arvore de proteina (chamando liberar_arvore)
-     *    c. Libera lista de alimentos (chamando liberar_lista_alimentos)
-     *    d. Libera o no de categoria
-     * 2. Retorna NULL
-     *
-     * IMPORTANTE: Apos liberar, lista_categorias aponta para memoria
-     * invalida, mas nao importa porque programa esta encerrando
+    /* liberar_base_dados (definida em arquivo.c) faz:
+     * 1. Libera a arena: categorias, alimentos e nos das arvores foram
+     *    alocados nela, entao saem todos de uma vez, sem percorrer os nos
+     * 2. Libera a tabela do registro de categorias
+     * 3. Libera o indice de alimentos por numero
+     * 4. Libera a tabela colunar
+     * 5. Libera a arvore k-d dos nutrientes
+     * 6. Desfaz o mapeamento de dados.bin
      */
-    liberar_categorias(lista_categorias);
+    liberar_base_dados(&base);
 
     /*** PASSO 12: RETORNAR CODIGO DE SAIDA ***/
 
@@ -304,13 +307,14 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
  * dados.bin (arquivo em disco)
  *     |
  *     v
- * carregar_dados_binario() le arquivo
+ * carregar_dados_binario() mapeia o arquivo em memoria
  *     |
  *     v
  * Cria estruturas em memoria:
  * - Lista encadeada de categorias (NoCategoria)
+ * - Registro de categorias (busca por nome em tabela hash)
+ * - Tabela colunar de alimentos (uma particao por categoria)
  * - Para cada categoria:
- *   * Lista encadeada de alimentos (NoAlimento)
  *   * Arvore binaria por energia (NoArvore)
  *   * Arvore binaria por proteina (NoArvore)
  *     |
@@ -328,7 +332,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
  * salvar_dados_binario() grava de volta em dados.bin
  *     |
  *     v
- * liberar_categorias() libera toda memoria
+ * liberar_base_dados() libera toda memoria e o mapeamento
  *     |
  *     v
  * Programa encerra
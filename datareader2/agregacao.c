@@ -0,0 +1,303 @@
+#include "agregacao.h"
+#include "arvore.h"
+#include "tabela.h"
+#include "simd.h"
+#include <string.h>
+
+#define LINHAS_POR_BLOCO 4
+
+/* Os nucleos acumulam em SomasNutriente (ver tipos.h): somas dos valores
+ * menos a referencia, que evita o cancelamento de soma_quadrados - soma^2/n
+ * quando a media e grande perto do desvio */
+typedef void (*NucleoAgregacao)(const TabelaAlimentos*, size_t, size_t, SomasNutriente*, size_t*);
+
+/* Valor de um nutriente na linha, como double */
+static double valor_coluna(const TabelaAlimentos* tabela, int coluna, size_t linha) {
+    switch (coluna) {
+        case COLUNA_UMIDADE: return tabela->umidade[linha];
+        case COLUNA_ENERGIA: return tabela->energia_kcal[linha];
+        case COLUNA_PROTEINA: return tabela->proteina[linha];
+        default: return tabela->carboidrato[linha];
+    }
+}
+
+/* Escalar: visita so as linhas presentes de [inicio, fim) */
+static void agregar_escalar(const TabelaAlimentos* tabela, size_t inicio, size_t fim,
+                            SomasNutriente* somas, size_t* quantidade) {
+    size_t l;
+    for (l = proxima_linha(tabela, inicio, fim); l < fim; l = proxima_linha(tabela, l + 1, fim)) {
+        for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+            double x = valor_coluna(tabela, c, l);
+            double d = x - somas[c].referencia;
+            somas[c].soma += d;
+            somas[c].soma_quadrados += d * d;
+            if (x < somas[c].minimo) {
+                somas[c].minimo = x;
+            }
+            if (x > somas[c].maximo) {
+                somas[c].maximo = x;
+            }
+        }
+        (*quantidade)++;
+    }
+}
+
+#ifdef SIMD_X86
+/* AVX2: 4 linhas por vez, os 4 nutrientes no mesmo laco. Os bits de presenca
+ * do bloco viram uma mascara; linhas removidas somam zero e nao mexem no
+ * minimo/maximo. Os blocos comecam em multiplo de 4, entao nunca cruzam uma
+ * palavra do mapa de bits; cabeca e cauda da faixa ficam com o escalar. */
+__attribute__((target("avx2")))
+static void agregar_avx2(const TabelaAlimentos* tabela, size_t inicio, size_t fim,
+                         SomasNutriente* somas, size_t* quantidade) {
+    size_t inicio_vetor = (inicio + LINHAS_POR_BLOCO - 1) / LINHAS_POR_BLOCO * LINHAS_POR_BLOCO;
+    if (inicio_vetor > fim) {
+        inicio_vetor = fim;
+    }
+    size_t fim_vetor = inicio_vetor + (fim - inicio_vetor) / LINHAS_POR_BLOCO * LINHAS_POR_BLOCO;
+    agregar_escalar(tabela, inicio, inicio_vetor, somas, quantidade);
+
+    const __m256i bits_linha = _mm256_set_epi64x(8, 4, 2, 1);
+    const __m256d mais_infinito = _mm256_set1_pd(__builtin_inf());
+    const __m256d menos_infinito = _mm256_set1_pd(-__builtin_inf());
+    __m256d soma[TOTAL_NUTRIENTES], quadrados[TOTAL_NUTRIENTES];
+    __m256d minimo[TOTAL_NUTRIENTES], maximo[TOTAL_NUTRIENTES], desloc[TOTAL_NUTRIENTES];
+    for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+        soma[c] = _mm256_setzero_pd();
+        quadrados[c] = _mm256_setzero_pd();
+        minimo[c] = mais_infinito;
+        maximo[c] = menos_infinito;
+        desloc[c] = _mm256_set1_pd(somas[c].referencia);
+    }
+
+    size_t presentes = 0;
+    for (size_t l = inicio_vetor; l < fim_vetor; l += LINHAS_POR_BLOCO) {
+        unsigned bits = (unsigned)(tabela->presenca[l / BITS_POR_PALAVRA] >> (l % BITS_POR_PALAVRA)) & 0xF;
+        if (bits == 0) {
+            continue;
+        }
+        presentes += (size_t)__builtin_popcount(bits);
+        __m256i sel = _mm256_and_si256(_mm256_set1_epi64x(bits), bits_linha);
+        __m256d mascara = _mm256_castsi256_pd(_mm256_cmpeq_epi64(sel, bits_linha));
+
+        __m256d x[TOTAL_NUTRIENTES];
+        x[COLUNA_UMIDADE] = _mm256_loadu_pd(tabela->umidade + l);
+        x[COLUNA_ENERGIA] = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(tabela->energia_kcal + l)));
+        x[COLUNA_PROTEINA] = _mm256_loadu_pd(tabela->proteina + l);
+        x[COLUNA_CARBOIDRATO] = _mm256_loadu_pd(tabela->carboidrato + l);
+        for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+            __m256d d = _mm256_and_pd(_mm256_sub_pd(x[c], desloc[c]), mascara);
+            soma[c] = _mm256_add_pd(soma[c], d);
+            quadrados[c] = _mm256_add_pd(quadrados[c], _mm256_mul_pd(d, d));
+            minimo[c] = _mm256_min_pd(minimo[c], _mm256_blendv_pd(mais_infinito, x[c], mascara));
+            maximo[c] = _mm256_max_pd(maximo[c], _mm256_blendv_pd(menos_infinito, x[c], mascara));
+        }
+    }
+
+    for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+        double s[LINHAS_POR_BLOCO], q[LINHAS_POR_BLOCO], mn[LINHAS_POR_BLOCO], mx[LINHAS_POR_BLOCO];
+        _mm256_storeu_pd(s, soma[c]);
+        _mm256_storeu_pd(q, quadrados[c]);
+        _mm256_storeu_pd(mn, minimo[c]);
+        _mm256_storeu_pd(mx, maximo[c]);
+        for (int i = 0; i < LINHAS_POR_BLOCO; i++) {
+            somas[c].soma += s[i];
+            somas[c].soma_quadrados += q[i];
+            if (mn[i] < somas[c].minimo) {
+                somas[c].minimo = mn[i];
+            }
+            if (mx[i] > somas[c].maximo) {
+                somas[c].maximo = mx[i];
+            }
+        }
+    }
+    *quantidade += presentes;
+
+    agregar_escalar(tabela, fim_vetor, fim, somas, quantidade);
+}
+#endif
+
+static NucleoAgregacao nucleo_agregacao = NULL;
+static NivelSimd nivel_nucleo = NIVEL_ESCALAR;
+
+/* Escolhe o nucleo uma vez; so ha versao vetorizada para AVX2 */
+static void escolher_nucleo(void) {
+    if (nucleo_agregacao != NULL) {
+        return;
+    }
+    nucleo_agregacao = agregar_escalar;
+#ifdef SIMD_X86
+    if (nivel_simd() == NIVEL_AVX2) {
+        nucleo_agregacao = agregar_avx2;
+        nivel_nucleo = NIVEL_AVX2;
+    }
+#endif
+}
+
+/* Nome do nivel do nucleo de agregacao (AVX2 ou escalar) */
+const char* nivel_simd_agregacao(void) {
+    escolher_nucleo();
+    return nome_nivel_simd(nivel_nucleo);
+}
+
+/* Calcula as somas de uma particao em uma passada pelo nucleo escolhido */
+static void somar_particao(const TabelaAlimentos* tabela, const ParticaoTabela* particao,
+                           EstatisticasCategoria* estatisticas) {
+    memset(estatisticas, 0, sizeof(*estatisticas));
+    size_t primeira = proxima_linha(tabela, particao->inicio, particao->fim);
+    if (primeira >= particao->fim) {
+        return;
+    }
+
+    for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+        double x = valor_coluna(tabela, c, primeira);
+        estatisticas->nutrientes[c].referencia = x;
+        estatisticas->nutrientes[c].minimo = x;
+        estatisticas->nutrientes[c].maximo = x;
+    }
+    escolher_nucleo();
+    nucleo_agregacao(tabela, primeira, particao->fim, estatisticas->nutrientes, &estatisticas->quantidade);
+}
+
+/* Converte as somas em soma, media, minimo, maximo e variancia */
+static void finalizar_resumo(const EstatisticasCategoria* estatisticas, ResumoCategoria* resumo) {
+    resumo->quantidade = estatisticas->quantidade;
+    if (estatisticas->quantidade == 0) {
+        memset(resumo->nutrientes, 0, sizeof(resumo->nutrientes));
+        return;
+    }
+
+    double n = (double)estatisticas->quantidade;
+    for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+        const SomasNutriente* s = &estatisticas->nutrientes[c];
+        EstatisticaNutriente* e = &resumo->nutrientes[c];
+        double media_deslocada = s->soma / n;
+        e->soma = s->referencia * n + s->soma;
+        e->media = s->referencia + media_deslocada;
+        e->minimo = s->minimo;
+        e->maximo = s->maximo;
+        e->variancia = s->soma_quadrados / n - media_deslocada * media_deslocada;
+        if (e->variancia < 0.0) {
+            e->variancia = 0.0;
+        }
+    }
+}
+
+/* Agrega as linhas presentes de uma particao: quantidade, soma, media,
+ * minimo, maximo e variancia (populacional) de cada nutriente */
+void agregar_particao(const TabelaAlimentos* tabela, const ParticaoTabela* particao, ResumoCategoria* resumo) {
+    EstatisticasCategoria estatisticas;
+    somar_particao(tabela, particao, &estatisticas);
+    resumo->categoria = particao->categoria;
+    finalizar_resumo(&estatisticas, resumo);
+}
+
+/* Agrega todos os nutrientes agrupados por categoria, em uma passada pela
+ * tabela. resumos precisa de espaco para tabela->total_particoes; retorna
+ * quantos foram preenchidos (categorias removidas ficam de fora). */
+size_t agregar_por_categoria(const TabelaAlimentos* tabela, ResumoCategoria* resumos) {
+    size_t total = 0;
+    for (size_t p = 0; p < tabela->total_particoes; p++) {
+        if (tabela->particoes[p].categoria == NULL) {
+            continue;
+        }
+        agregar_particao(tabela, &tabela->particoes[p], &resumos[total]);
+        total++;
+    }
+    return total;
+}
+
+/* Acumula um resumo parcial em total (para somar categorias). Medias e
+ * variancias se juntam pela formula de grupos em paralelo (Chan et al.).
+ * total deve comecar zerado. */
+void combinar_resumos(ResumoCategoria* total, const ResumoCategoria* parte) {
+    if (parte->quantidade == 0) {
+        return;
+    }
+    if (total->quantidade == 0) {
+        const NoCategoria* categoria = total->categoria;
+        *total = *parte;
+        total->categoria = categoria;
+        return;
+    }
+
+    double n_a = (double)total->quantidade;
+    double n_b = (double)parte->quantidade;
+    double n = n_a + n_b;
+    for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+        EstatisticaNutriente* a = &total->nutrientes[c];
+        const EstatisticaNutriente* b = &parte->nutrientes[c];
+        double delta = b->media - a->media;
+        double m2 = a->variancia * n_a + b->variancia * n_b + delta * delta * n_a * n_b / n;
+        a->soma += b->soma;
+        a->media += delta * n_b / n;
+        a->variancia = m2 / n;
+        if (b->minimo < a->minimo) {
+            a->minimo = b->minimo;
+        }
+        if (b->maximo > a->maximo) {
+            a->maximo = b->maximo;
+        }
+    }
+    total->quantidade += parte->quantidade;
+}
+
+/* Calcula do zero as estatisticas mantidas na categoria (ao carregar) */
+void calcular_estatisticas_categoria(const TabelaAlimentos* tabela, NoCategoria* categoria) {
+    somar_particao(tabela, particao_categoria(tabela, categoria), &categoria->estatisticas);
+}
+
+/* Atualiza um minimo ou maximo depois de retirar um alimento que tinha esse
+ * valor. Enquanto outros alimentos o tem, so desconta; quando o ultimo sai
+ * (ou a contagem ainda nao existe), procura o novo extremo na ponta do
+ * indice padrao da coluna na categoria (O(log n)). */
+static void atualizar_extremo(const NoCategoria* categoria, int coluna, bool maior,
+                              double* extremo, size_t* quantos) {
+    if (*quantos > 1) {
+        (*quantos)--;
+        return;
+    }
+
+    /* Os indices padrao dos nutrientes tem o numero da coluna (ver indices.h) */
+    NoArvore* arvore = categoria->indices[coluna];
+    *extremo = (maior ? maior_no_arvore(arvore) : menor_no_arvore(arvore))->chave;
+    *quantos = contar_chave_arvore(arvore, *extremo);
+}
+
+/* Desconta um alimento das estatisticas da categoria. Deve ser chamada
+ * depois que a linha saiu da tabela e dos indices. Somas e contagem sao
+ * atualizadas em O(1); minimo e maximo so sao procurados de novo quando
+ * sai o ultimo alimento com aquele valor. */
+void descontar_estatisticas_categoria(NoCategoria* categoria, const NoAlimento* alimento) {
+    EstatisticasCategoria* estatisticas = &categoria->estatisticas;
+    if (estatisticas->quantidade <= 1) {
+        memset(estatisticas, 0, sizeof(*estatisticas));
+        return;
+    }
+
+    double valores[TOTAL_NUTRIENTES];
+    valores[COLUNA_UMIDADE] = alimento->umidade;
+    valores[COLUNA_ENERGIA] = (double)alimento->energia_kcal;
+    valores[COLUNA_PROTEINA] = alimento->proteina;
+    valores[COLUNA_CARBOIDRATO] = alimento->carboidrato;
+
+    estatisticas->quantidade--;
+    for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+        SomasNutriente* s = &estatisticas->nutrientes[c];
+        double d = valores[c] - s->referencia;
+        s->soma -= d;
+        s->soma_quadrados -= d * d;
+        if (valores[c] == s->minimo) {
+            atualizar_extremo(categoria, c, false, &s->minimo, &s->no_minimo);
+        }
+        if (valores[c] == s->maximo) {
+            atualizar_extremo(categoria, c, true, &s->maximo, &s->no_maximo);
+        }
+    }
+}
+
+/* Le as estatisticas mantidas na categoria, em O(1) */
+void ler_estatisticas_categoria(const NoCategoria* categoria, ResumoCategoria* resumo) {
+    resumo->categoria = categoria;
+    finalizar_resumo(&categoria->estatisticas, resumo);
+}
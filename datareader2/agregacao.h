@@ -0,0 +1,47 @@
+#ifndef AGREGACAO_H
+#define AGREGACAO_H
+
+#include "tipos.h"
+
+/* Estatisticas de um nutriente em um grupo de alimentos (variancia populacional) */
+typedef struct {
+    double soma;
+    double media;
+    double minimo;
+    double maximo;
+    double variancia;
+} EstatisticaNutriente;
+
+/* Resumo de um grupo: uma categoria, ou todas quando categoria e NULL */
+typedef struct {
+    const NoCategoria* categoria;
+    size_t quantidade;
+    EstatisticaNutriente nutrientes[TOTAL_NUTRIENTES];
+} ResumoCategoria;
+
+/* Nivel do nucleo de agregacao em uso: AVX2 ou escalar (ver simd.h) */
+const char* nivel_simd_agregacao(void);
+
+/* Agrega as linhas presentes de uma particao da tabela */
+void agregar_particao(const TabelaAlimentos* tabela, const ParticaoTabela* particao, ResumoCategoria* resumo);
+
+/* Agrega todos os nutrientes agrupados por categoria, em uma passada pela
+ * tabela. resumos precisa de espaco para tabela->total_particoes; retorna
+ * quantos foram preenchidos (categorias removidas ficam de fora). */
+size_t agregar_por_categoria(const TabelaAlimentos* tabela, ResumoCategoria* resumos);
+
+/* Calcula do zero as estatisticas mantidas na categoria (ao carregar) */
+void calcular_estatisticas_categoria(const TabelaAlimentos* tabela, NoCategoria* categoria);
+
+/* Desconta um alimento das estatisticas da categoria, depois que ele saiu
+ * da tabela e dos indices. Minimo e maximo so sao recalculados quando o
+ * alimento era o extremo (pela ponta do indice padrao da coluna). */
+void descontar_estatisticas_categoria(NoCategoria* categoria, const NoAlimento* alimento);
+
+/* Le as estatisticas mantidas na categoria, em O(1) */
+void ler_estatisticas_categoria(const NoCategoria* categoria, ResumoCategoria* resumo);
+
+/* Acumula um resumo parcial em total (para somar categorias) */
+void combinar_resumos(ResumoCategoria* total, const ResumoCategoria* parte);
+
+#endif
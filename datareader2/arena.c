@@ -0,0 +1,74 @@
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ALINHAMENTO_ARENA 8
+#define CAPACIDADE_MINIMA_BLOCO 4096
+
+/* Bloco de memoria da arena; os dados vem logo depois do cabecalho */
+typedef struct BlocoArena {
+    struct BlocoArena* anterior;
+    size_t capacidade;
+    size_t usado;
+} BlocoArena;
+
+/* Arredonda um tamanho para o proximo multiplo do alinhamento */
+static size_t alinhar(size_t tamanho) {
+    return (tamanho + ALINHAMENTO_ARENA - 1) & ~(size_t)(ALINHAMENTO_ARENA - 1);
+}
+
+/* Acrescenta um bloco novo a arena, com pelo menos minimo bytes livres */
+static void novo_bloco(Arena* arena, size_t minimo) {
+    size_t capacidade = arena->proxima_capacidade;
+    if (capacidade < minimo) {
+        capacidade = minimo;
+    }
+
+    BlocoArena* bloco = (BlocoArena*)malloc(sizeof(BlocoArena) + capacidade);
+    if (bloco == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para a arena.\n");
+        exit(1);
+    }
+    bloco->anterior = arena->bloco;
+    bloco->capacidade = capacidade;
+    bloco->usado = 0;
+    arena->bloco = bloco;
+
+    /* Blocos seguintes dobram de tamanho: poucos blocos para liberar */
+    arena->proxima_capacidade = capacidade * 2;
+}
+
+/* Prepara a arena; o primeiro bloco tera pelo menos capacidade_inicial bytes */
+void inicializar_arena(Arena* arena, size_t capacidade_inicial) {
+    arena->bloco = NULL;
+    arena->proxima_capacidade = capacidade_inicial > CAPACIDADE_MINIMA_BLOCO
+                                ? alinhar(capacidade_inicial) : CAPACIDADE_MINIMA_BLOCO;
+}
+
+/* Aloca memoria da arena por incremento de ponteiro (alinhada a 8 bytes) */
+void* alocar_na_arena(Arena* arena, size_t tamanho) {
+    tamanho = alinhar(tamanho > 0 ? tamanho : 1);
+
+    if (arena->bloco == NULL || arena->bloco->capacidade - arena->bloco->usado < tamanho) {
+        if (arena->proxima_capacidade == 0) {
+            arena->proxima_capacidade = CAPACIDADE_MINIMA_BLOCO;
+        }
+        novo_bloco(arena, tamanho);
+    }
+
+    void* memoria = (unsigned char*)(arena->bloco + 1) + arena->bloco->usado;
+    arena->bloco->usado += tamanho;
+    return memoria;
+}
+
+/* Libera todos os blocos da arena de uma vez */
+void liberar_arena(Arena* arena) {
+    BlocoArena* bloco = arena->bloco;
+    while (bloco != NULL) {
+        BlocoArena* anterior = bloco->anterior;
+        free(bloco);
+        bloco = anterior;
+    }
+    arena->bloco = NULL;
+    arena->proxima_capacidade = 0;
+}
@@ -0,0 +1,16 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "tipos.h"
+
+/* Prepara a arena; o primeiro bloco tera pelo menos capacidade_inicial bytes */
+void inicializar_arena(Arena* arena, size_t capacidade_inicial);
+
+/* Aloca memoria da arena por incremento de ponteiro (alinhada a 8 bytes).
+ * A memoria so e devolvida quando a arena inteira e liberada. */
+void* alocar_na_arena(Arena* arena, size_t tamanho);
+
+/* Libera todos os blocos da arena de uma vez */
+void liberar_arena(Arena* arena);
+
+#endif
@@ -1,74 +1,389 @@
+#define _POSIX_C_SOURCE 200809L
 #include "arquivo.h"
+#include "agregacao.h"
+#include "arena.h"
+#include "arvore_kd.h"
 #include "categoria.h"
+#include "formato.h"
+#include "indice_numero.h"
+#include "indices.h"
+#include "registro.h"
+#include "tabela.h"
 #include "utils.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* Le o arquivo binario e constroi as listas ligadas de categorias e alimentos */
-NoCategoria* carregar_dados_binario(const char* arquivo_bin) {
-    FILE* arquivo = fopen(arquivo_bin, "rb");
-    if (arquivo == NULL) {
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Mapeia um arquivo em memoria para leitura */
+bool mapear_arquivo(const char* caminho, MapaArquivo* mapa) {
+    memset(mapa, 0, sizeof(MapaArquivo));
+
+#ifdef _WIN32
+    /* FILE_SHARE_DELETE permite renomear o arquivo enquanto ele esta mapeado */
+    HANDLE arquivo = CreateFileA(caminho, GENERIC_READ,
+                                 FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivo == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "Erro ao abrir arquivo binario: %s\n", caminho);
+        return false;
+    }
+
+    LARGE_INTEGER tamanho;
+    if (!GetFileSizeEx(arquivo, &tamanho) || tamanho.QuadPart == 0) {
+        CloseHandle(arquivo);
+        fprintf(stderr, "Arquivo binario vazio ou invalido: %s\n", caminho);
+        return false;
+    }
+
+    HANDLE mapeamento = CreateFileMappingA(arquivo, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapeamento == NULL) {
+        CloseHandle(arquivo);
+        fprintf(stderr, "Erro ao mapear arquivo binario: %s\n", caminho);
+        return false;
+    }
+
+    void* dados = MapViewOfFile(mapeamento, FILE_MAP_READ, 0, 0, 0);
+    if (dados == NULL) {
+        CloseHandle(mapeamento);
+        CloseHandle(arquivo);
+        fprintf(stderr, "Erro ao mapear arquivo binario: %s\n", caminho);
+        return false;
+    }
+
+    mapa->dados = (const unsigned char*)dados;
+    mapa->tamanho = (size_t)tamanho.QuadPart;
+    mapa->arquivo = arquivo;
+    mapa->mapeamento = mapeamento;
+#else
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
         perror("Erro ao abrir arquivo binario");
-        return NULL;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        fprintf(stderr, "Arquivo binario vazio ou invalido: %s\n", caminho);
+        return false;
+    }
+
+    void* dados = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (dados == MAP_FAILED) {
+        perror("Erro ao mapear arquivo binario");
+        return false;
+    }
+
+    /* O arquivo inteiro sera lido na carga; antecipa as leituras do disco */
+    posix_madvise(dados, (size_t)info.st_size, POSIX_MADV_WILLNEED);
+
+    mapa->dados = (const unsigned char*)dados;
+    mapa->tamanho = (size_t)info.st_size;
+#endif
+
+    return true;
+}
+
+/* Desfaz o mapeamento de um arquivo */
+void desmapear_arquivo(MapaArquivo* mapa) {
+    if (mapa->dados == NULL) {
+        return;
     }
 
-    NoCategoria* lista_categorias = NULL;
-    AlimentoArquivo alimento_temp;
+#ifdef _WIN32
+    UnmapViewOfFile(mapa->dados);
+    CloseHandle((HANDLE)mapa->mapeamento);
+    CloseHandle((HANDLE)mapa->arquivo);
+#else
+    munmap((void*)mapa->dados, mapa->tamanho);
+#endif
 
-    while (fread(&alimento_temp, sizeof(AlimentoArquivo), 1, arquivo) == 1) {
-        NoCategoria* categoria = buscar_categoria(lista_categorias, alimento_temp.categoria);
+    memset(mapa, 0, sizeof(MapaArquivo));
+}
 
-        if (categoria == NULL) {
-            categoria = criar_no_categoria(alimento_temp.categoria);
-            lista_categorias = inserir_categoria_ordenada(lista_categorias, categoria);
+/* Verifica se uma categoria deve ser carregada (filtro vazio carrega todas) */
+static bool categoria_selecionada(const char* nome, const char* const* categorias, size_t total_categorias) {
+    if (categorias == NULL) {
+        return true;
+    }
+    for (size_t i = 0; i < total_categorias; i++) {
+        if (strcmp(categorias[i], nome) == 0) {
+            return true;
         }
+    }
+    return false;
+}
 
-        NoAlimento* novo_alimento = criar_no_alimento(&alimento_temp);
-        categoria->lista_alimentos = inserir_alimento_ordenado(categoria->lista_alimentos, novo_alimento);
+/* Liga um alimento carregado a sua categoria e ao indice por numero.
+ * A ordem por descricao so e feita ao montar a tabela, depois da leitura.
+ * Um numero repetido so fica acessivel pela sua primeira ocorrencia. */
+static void ligar_alimento(BaseDados* base, NoCategoria* categoria, NoAlimento* alimento) {
+    alimento->categoria = categoria;
+    if (!inserir_indice_numero(&base->numeros, alimento, categoria)) {
+        fprintf(stderr, "Aviso: numero de alimento %d repetido no arquivo.\n", alimento->numero);
     }
+}
 
-    fclose(arquivo);
+/* Acrescenta um registro do mapeamento a sua categoria */
+static void adicionar_registro(BaseDados* base, NoCategoria* categoria, const AlimentoArquivo* registro) {
+    NoAlimento* novo_alimento = &base->alimentos[base->total_alimentos++];
+    inicializar_no_alimento(novo_alimento, registro);
+    ligar_alimento(base, categoria, novo_alimento);
+}
 
-    NoCategoria* atual = lista_categorias;
-    while (atual != NULL) {
-        construir_arvores_categoria(atual);
-        atual = atual->proximo;
+/* Tamanho da arena para a carga: alimentos, categorias e as arvores dos
+ * indices padrao, para que todos os nos caibam em um unico bloco contiguo */
+static size_t estimar_tamanho_arena(size_t total_alimentos, size_t total_categorias) {
+    if (total_categorias == 0) {
+        /* Arquivo sem diretorio: reserva as categorias conhecidas */
+        total_categorias = TOTAL_CATEGORIAS;
+    }
+    return total_alimentos * (sizeof(NoAlimento) + TOTAL_INDICES_PADRAO * sizeof(NoArvore)) +
+           total_categorias * sizeof(NoCategoria);
+}
+
+/* Cria o no de uma categoria carregada, inserindo-o na lista e no registro.
+ * Nomes fora de categorias.def sao aceitos, mas avisados. */
+static NoCategoria* adicionar_categoria(BaseDados* base, const char* nome) {
+    NoCategoria* categoria = criar_no_categoria(&base->arena, nome);
+    if (categoria->tipo == CATEGORIA_INVALIDA) {
+        fprintf(stderr, "Aviso: categoria desconhecida '%s' no arquivo.\n", categoria->nome);
+    }
+    base->lista_categorias = inserir_categoria_ordenada(base->lista_categorias, categoria);
+    registrar_categoria(&base->categorias, categoria);
+    return categoria;
+}
+
+/* Carrega um arquivo legado (versao 1): sequencia de registros sem cabecalho.
+ * A categoria de cada nome novo e buscada no registro (hash); os registros
+ * seguintes so comparam com o nome do registro anterior (eles vem agrupados
+ * por categoria). */
+static bool carregar_legado(BaseDados* base, const char* const* categorias, size_t total_categorias) {
+    size_t total = base->mapa.tamanho / sizeof(AlimentoArquivo);
+    const AlimentoArquivo* registros = (const AlimentoArquivo*)base->mapa.dados;
+
+    inicializar_arena(&base->arena, estimar_tamanho_arena(total, 0));
+    inicializar_registro(&base->categorias, TOTAL_CATEGORIAS);
+    inicializar_indice_numero(&base->numeros, total);
+    base->alimentos = (NoAlimento*)alocar_na_arena(&base->arena, total * sizeof(NoAlimento));
+
+    const char* ultimo_nome = NULL;
+    NoCategoria* ultima = NULL;    /* NULL se a categoria nao foi selecionada */
+    for (size_t i = 0; i < total; i++) {
+        const AlimentoArquivo* registro = &registros[i];
+
+        /* As strings sao usadas direto do mapeamento: exige o terminador */
+        if (registro->descricao[MAX_DESCRICAO - 1] != '\0' ||
+            registro->categoria[MAX_CATEGORIA - 1] != '\0') {
+            fprintf(stderr, "Registro %lu invalido no arquivo binario.\n", (unsigned long)i);
+            return false;
+        }
+
+        if (ultimo_nome == NULL || strcmp(ultimo_nome, registro->categoria) != 0) {
+            ultimo_nome = registro->categoria;
+            ultima = buscar_categoria_registro(&base->categorias, registro->categoria);
+            if (ultima == NULL && categoria_selecionada(registro->categoria, categorias, total_categorias)) {
+                ultima = adicionar_categoria(base, registro->categoria);
+            }
+        }
+
+        if (ultima != NULL) {
+            adicionar_registro(base, ultima, registro);
+        }
+    }
+
+    return true;
+}
+
+/* Conta os registros das categorias selecionadas e aloca os nos de uma vez */
+static void alocar_nos_diretorio(BaseDados* base, const char* const* categorias, size_t total_categorias) {
+    const CabecalhoArquivo* cabecalho = (const CabecalhoArquivo*)base->mapa.dados;
+    const EntradaDiretorio* diretorio = (const EntradaDiretorio*)(base->mapa.dados + sizeof(CabecalhoArquivo));
+
+    size_t total = 0;
+    for (uint32_t c = 0; c < cabecalho->total_categorias; c++) {
+        if (categoria_selecionada(diretorio[c].nome, categorias, total_categorias)) {
+            total += diretorio[c].quantidade;
+        }
     }
 
-    return lista_categorias;
+    inicializar_arena(&base->arena, estimar_tamanho_arena(total, cabecalho->total_categorias));
+    inicializar_registro(&base->categorias, cabecalho->total_categorias);
+    inicializar_indice_numero(&base->numeros, total);
+    base->alimentos = (NoAlimento*)alocar_na_arena(&base->arena, total * sizeof(NoAlimento));
 }
 
-/* Salva os dados atualizados no arquivo binario */
-bool salvar_dados_binario(NoCategoria* lista_categorias, const char* arquivo_bin) {
-    FILE* arquivo = fopen(arquivo_bin, "wb");
-    if (arquivo == NULL) {
-        perror("Erro ao criar arquivo binario");
+/* Acrescenta a linha i de um arquivo colunar a sua categoria */
+static bool adicionar_linha(BaseDados* base, NoCategoria* categoria, const ColunasArquivo* colunas, size_t i) {
+    /* A referencia deve cair dentro do pool, depois do prefixo de
+     * tamanho, e o texto deve terminar em '\0' */
+    RefTexto ref = colunas->descricao[i];
+    if (ref.offset < sizeof(uint32_t) || (uint64_t)ref.offset + ref.tamanho >= colunas->tamanho_textos ||
+        colunas->textos[ref.offset + ref.tamanho] != '\0') {
+        fprintf(stderr, "Registro invalido na categoria %s.\n", categoria->nome);
         return false;
     }
 
-    NoCategoria* cat_atual = lista_categorias;
-    while (cat_atual != NULL) {
-        NoAlimento* alim_atual = cat_atual->lista_alimentos;
-        while (alim_atual != NULL) {
-            AlimentoArquivo temp;
-            memset(&temp, 0, sizeof(AlimentoArquivo));
+    NoAlimento* novo_alimento = &base->alimentos[base->total_alimentos++];
+    novo_alimento->numero = colunas->numero[i];
+    novo_alimento->descricao = colunas->textos + ref.offset;
+    novo_alimento->tamanho_descricao = ref.tamanho;
+    novo_alimento->umidade = colunas->umidade[i];
+    novo_alimento->energia_kcal = colunas->energia_kcal[i];
+    novo_alimento->proteina = colunas->proteina[i];
+    novo_alimento->carboidrato = colunas->carboidrato[i];
+    ligar_alimento(base, categoria, novo_alimento);
+    return true;
+}
+
+/* Carrega um arquivo colunar: cada campo do no vem de sua propria coluna e a
+ * descricao aponta para o pool de textos do mapeamento. Os nos de categoria
+ * sao criados uma vez, a partir do diretorio, e so as faixas de linhas das
+ * categorias selecionadas sao lidas; a coluna de codigos apenas confirma
+ * que cada linha pertence a faixa em que esta. */
+static bool carregar_colunar(BaseDados* base, const char* const* categorias, size_t total_categorias) {
+    const CabecalhoArquivo* cabecalho = (const CabecalhoArquivo*)base->mapa.dados;
+    const EntradaDiretorio* diretorio = (const EntradaDiretorio*)(base->mapa.dados + sizeof(CabecalhoArquivo));
 
-            temp.numero = alim_atual->numero;
-            temp.umidade = alim_atual->umidade;
-            temp.energia_kcal = alim_atual->energia_kcal;
-            temp.proteina = alim_atual->proteina;
-            temp.carboidrato = alim_atual->carboidrato;
+    alocar_nos_diretorio(base, categorias, total_categorias);
 
-            strncpy(temp.descricao, alim_atual->descricao, MAX_DESCRICAO - 1);
-            strncpy(temp.categoria, cat_atual->nome, MAX_CATEGORIA - 1);
+    ColunasArquivo colunas;
+    obter_colunas_arquivo(base->mapa.dados, base->mapa.tamanho, &colunas);
 
-            fwrite(&temp, sizeof(AlimentoArquivo), 1, arquivo);
-            alim_atual = alim_atual->proximo;
+    bool sucesso = true;
+    for (uint32_t c = 0; c < cabecalho->total_categorias && sucesso; c++) {
+        if (!categoria_selecionada(diretorio[c].nome, categorias, total_categorias)) {
+            continue;
         }
-        cat_atual = cat_atual->proximo;
+
+        NoCategoria* categoria = adicionar_categoria(base, diretorio[c].nome);
+        uint64_t fim = diretorio[c].offset + diretorio[c].quantidade;
+        for (uint64_t i = diretorio[c].offset; i < fim && sucesso; i++) {
+            if (colunas.categoria[i] != c) {
+                fprintf(stderr, "Codigo de categoria invalido na linha %lu.\n", (unsigned long)i);
+                sucesso = false;
+            } else {
+                sucesso = adicionar_linha(base, categoria, &colunas, (size_t)i);
+            }
+        }
+    }
+
+    return sucesso;
+}
+
+/* Mapeia o arquivo binario e carrega somente as categorias indicadas.
+ * Todos os nos sao alocados em sequencia na arena da base e as descricoes
+ * sao servidas diretamente do mapeamento, sem copia. Depois da leitura os
+ * nos sao organizados na tabela colunar, com uma unica ordenacao por
+ * categoria, e os indices e a arvore k-d sao montados em lote. */
+bool carregar_categorias_binario(const char* arquivo_bin, const char* const* categorias,
+                                 size_t total_categorias, BaseDados* base) {
+    memset(base, 0, sizeof(BaseDados));
+
+    if (!mapear_arquivo(arquivo_bin, &base->mapa)) {
+        return false;
+    }
+
+    uint32_t versao = validar_arquivo_binario(base->mapa.dados, base->mapa.tamanho);
+    bool sucesso = false;
+
+    if (versao == FORMATO_VERSAO_LEGADA) {
+        sucesso = carregar_legado(base, categorias, total_categorias);
+    } else if (versao == FORMATO_VERSAO) {
+        sucesso = carregar_colunar(base, categorias, total_categorias);
+    } else {
+        fprintf(stderr, "Arquivo binario rejeitado: %s\n", arquivo_bin);
+    }
+
+    if (sucesso) {
+        sucesso = construir_tabela(&base->tabela, base->lista_categorias,
+                                   base->alimentos, base->total_alimentos);
+    }
+    if (!sucesso) {
+        liberar_base_dados(base);
+        return false;
+    }
+
+    inicializar_indices(&base->indices);
+    NoCategoria* atual = base->lista_categorias;
+    while (atual != NULL) {
+        construir_indices_categoria(&base->arena, &base->tabela, &base->indices, atual);
+        calcular_estatisticas_categoria(&base->tabela, atual);
+        atual = atual->proximo;
+    }
+    construir_indices_globais(&base->arena, &base->tabela, &base->indices);
+
+    if (!construir_arvore_kd(&base->nutrientes, &base->tabela)) {
+        liberar_base_dados(base);
+        return false;
     }
 
-    fclose(arquivo);
     return true;
 }
+
+/* Mapeia o arquivo binario e constroi a lista de categorias e a tabela de alimentos */
+bool carregar_dados_binario(const char* arquivo_bin, BaseDados* base) {
+    return carregar_categorias_binario(arquivo_bin, NULL, 0, base);
+}
+
+/* Salva os dados atualizados no arquivo binario: as linhas presentes da
+ * tabela, particao por particao (categorias em ordem alfabetica) */
+bool salvar_dados_binario(const BaseDados* base, const char* arquivo_bin) {
+    const TabelaAlimentos* tabela = &base->tabela;
+    size_t total = tabela->presentes;
+
+    RegistroAlimento* registros = (RegistroAlimento*)malloc((total > 0 ? total : 1) * sizeof(RegistroAlimento));
+    if (registros == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para salvar o arquivo binario.\n");
+        return false;
+    }
+
+    size_t i = 0;
+    for (size_t p = 0; p < tabela->total_particoes; p++) {
+        const ParticaoTabela* particao = &tabela->particoes[p];
+        if (particao->categoria == NULL) {
+            continue;
+        }
+        for (size_t linha = proxima_linha(tabela, particao->inicio, particao->fim); linha < particao->fim;
+             linha = proxima_linha(tabela, linha + 1, particao->fim)) {
+            const NoAlimento* alimento = tabela->alimento[linha];
+            registros[i].numero = tabela->numero[linha];
+            registros[i].descricao = alimento->descricao;
+            registros[i].tamanho_descricao = alimento->tamanho_descricao;
+            registros[i].umidade = tabela->umidade[linha];
+            registros[i].energia_kcal = tabela->energia_kcal[linha];
+            registros[i].proteina = tabela->proteina[linha];
+            registros[i].carboidrato = tabela->carboidrato[linha];
+            registros[i].categoria = particao->categoria->nome;
+            i++;
+        }
+    }
+
+    bool sucesso = gravar_arquivo_binario(arquivo_bin, registros, i);
+    free(registros);
+    return sucesso;
+}
+
+/* Libera todos os nos (de uma vez, junto com a arena), a tabela, o registro
+ * de categorias, o indice por numero, a arvore k-d e o mapeamento da base */
+void liberar_base_dados(BaseDados* base) {
+    liberar_arena(&base->arena);
+    liberar_registro(&base->categorias);
+    liberar_indice_numero(&base->numeros);
+    liberar_tabela(&base->tabela);
+    liberar_arvore_kd(&base->nutrientes);
+    desmapear_arquivo(&base->mapa);
+    base->lista_categorias = NULL;
+    base->alimentos = NULL;
+    base->total_alimentos = 0;
+}
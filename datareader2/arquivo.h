@@ -3,10 +3,24 @@
 
 #include "tipos.h"
 
-/* Le o arquivo binario e constroi as listas ligadas de categorias e alimentos */
-NoCategoria* carregar_dados_binario(const char* arquivo_bin);
+/* Mapeia um arquivo em memoria para leitura */
+bool mapear_arquivo(const char* caminho, MapaArquivo* mapa);
 
-/* Salva os dados atualizados no arquivo binario */
-bool salvar_dados_binario(NoCategoria* lista_categorias, const char* arquivo_bin);
+/* Desfaz o mapeamento de um arquivo */
+void desmapear_arquivo(MapaArquivo* mapa);
+
+/* Mapeia o arquivo binario e constroi a lista de categorias e a tabela de alimentos */
+bool carregar_dados_binario(const char* arquivo_bin, BaseDados* base);
+
+/* Mapeia o arquivo binario e carrega somente as categorias indicadas */
+bool carregar_categorias_binario(const char* arquivo_bin, const char* const* categorias,
+                                 size_t total_categorias, BaseDados* base);
+
+/* Salva os dados atualizados (linhas presentes da tabela) no arquivo binario */
+bool salvar_dados_binario(const BaseDados* base, const char* arquivo_bin);
+
+/* Libera todos os nos (de uma vez, junto com a arena), a tabela, o registro
+ * de categorias, o indice por numero, a arvore k-d e o mapeamento da base */
+void liberar_base_dados(BaseDados* base);
 
 #endif
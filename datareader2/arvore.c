@@ -1,128 +1,387 @@
 #include "arvore.h"
+#include "arena.h"
 #include <stdio.h>
 #include <stdlib.h>
 
-/* Cria um novo no de arvore binaria */
-NoArvore* criar_no_arvore(double chave, NoAlimento* alimento) {
-    NoArvore* novo = (NoArvore*)malloc(sizeof(NoArvore));
-    if (novo == NULL) {
-        fprintf(stderr, "Erro ao alocar memoria para no de arvore.\n");
-        exit(1);
-    }
+/* Cria um novo no de arvore binaria na arena */
+NoArvore* criar_no_arvore(Arena* arena, double chave, NoAlimento* alimento) {
+    NoArvore* novo = (NoArvore*)alocar_na_arena(arena, sizeof(NoArvore));
     novo->chave = chave;
     novo->alimento = alimento;
     novo->esquerda = NULL;
     novo->direita = NULL;
+    novo->altura = 1;
+    novo->tamanho = 1;
     return novo;
 }
 
-/* Insere um no na arvore binaria mantendo a propriedade de BST */
-NoArvore* inserir_na_arvore(NoArvore* raiz, double chave, NoAlimento* alimento) {
+/* Altura de uma subarvore (0 para vazia) */
+static int altura(const NoArvore* no) {
+    return no != NULL ? no->altura : 0;
+}
+
+/* Quantidade de nos da subarvore (0 para vazia) */
+size_t tamanho_arvore(const NoArvore* raiz) {
+    return raiz != NULL ? raiz->tamanho : 0;
+}
+
+/* Recalcula a altura e o tamanho de um no a partir dos filhos */
+static void atualizar_no(NoArvore* no) {
+    int esquerda = altura(no->esquerda);
+    int direita = altura(no->direita);
+    no->altura = (esquerda > direita ? esquerda : direita) + 1;
+    no->tamanho = tamanho_arvore(no->esquerda) + tamanho_arvore(no->direita) + 1;
+}
+
+/* Rotacao simples a direita: o filho esquerdo sobe */
+static NoArvore* rotacionar_direita(NoArvore* no) {
+    NoArvore* filho = no->esquerda;
+    no->esquerda = filho->direita;
+    filho->direita = no;
+    atualizar_no(no);
+    atualizar_no(filho);
+    return filho;
+}
+
+/* Rotacao simples a esquerda: o filho direito sobe */
+static NoArvore* rotacionar_esquerda(NoArvore* no) {
+    NoArvore* filho = no->direita;
+    no->direita = filho->esquerda;
+    filho->esquerda = no;
+    atualizar_no(no);
+    atualizar_no(filho);
+    return filho;
+}
+
+/* Restaura o balanceamento AVL de um no cujos filhos ja estao balanceados.
+ * As rotacoes preservam a ordem em-ordem, inclusive entre chaves iguais. */
+static NoArvore* balancear(NoArvore* no) {
+    atualizar_no(no);
+    int fator = altura(no->esquerda) - altura(no->direita);
+
+    if (fator > 1) {
+        if (altura(no->esquerda->esquerda) < altura(no->esquerda->direita)) {
+            no->esquerda = rotacionar_esquerda(no->esquerda);
+        }
+        return rotacionar_direita(no);
+    }
+    if (fator < -1) {
+        if (altura(no->direita->direita) < altura(no->direita->esquerda)) {
+            no->direita = rotacionar_direita(no->direita);
+        }
+        return rotacionar_esquerda(no);
+    }
+    return no;
+}
+
+/* Insere um no na arvore mantendo a propriedade de BST e o balanceamento AVL */
+NoArvore* inserir_na_arvore(Arena* arena, NoArvore* raiz, double chave, NoAlimento* alimento) {
     if (raiz == NULL) {
-        return criar_no_arvore(chave, alimento);
+        return criar_no_arvore(arena, chave, alimento);
     }
 
     if (chave < raiz->chave) {
-        raiz->esquerda = inserir_na_arvore(raiz->esquerda, chave, alimento);
+        raiz->esquerda = inserir_na_arvore(arena, raiz->esquerda, chave, alimento);
     } else {
-        raiz->direita = inserir_na_arvore(raiz->direita, chave, alimento);
+        raiz->direita = inserir_na_arvore(arena, raiz->direita, chave, alimento);
     }
 
-    return raiz;
+    return balancear(raiz);
 }
 
-/* Percorre a arvore em ordem decrescente (direita-raiz-esquerda) */
-void percorrer_decrescente(NoArvore* raiz) {
-    if (raiz == NULL) {
-        return;
+/* Compara entradas por chave e, em caso de empate, pela posicao original */
+static int comparar_entradas(const void* a, const void* b) {
+    const EntradaArvore* ea = (const EntradaArvore*)a;
+    const EntradaArvore* eb = (const EntradaArvore*)b;
+    if (ea->chave != eb->chave) {
+        return ea->chave < eb->chave ? -1 : 1;
     }
+    return ea->posicao < eb->posicao ? -1 : (ea->posicao > eb->posicao ? 1 : 0);
+}
 
-    percorrer_decrescente(raiz->direita);
-    printf("  %3d | %-50s | Energia: %4d kcal | Proteina: %5.1f g\n",
-           raiz->alimento->numero,
-           raiz->alimento->descricao,
-           raiz->alimento->energia_kcal,
-           raiz->alimento->proteina);
-    percorrer_decrescente(raiz->esquerda);
+/* Constroi recursivamente a subarvore das entradas [inicio, fim) ja ordenadas */
+static NoArvore* construir_intervalo(Arena* arena, const EntradaArvore* entradas, size_t inicio, size_t fim) {
+    if (inicio >= fim) {
+        return NULL;
+    }
+
+    size_t meio = inicio + (fim - inicio) / 2;
+    NoArvore* no = criar_no_arvore(arena, entradas[meio].chave, entradas[meio].alimento);
+    no->esquerda = construir_intervalo(arena, entradas, inicio, meio);
+    no->direita = construir_intervalo(arena, entradas, meio + 1, fim);
+    atualizar_no(no);
+    return no;
 }
 
-/* Percorre a arvore buscando valores em um intervalo [min, max] */
-void percorrer_intervalo(NoArvore* raiz, double min, double max) {
-    if (raiz == NULL) {
-        return;
+/* Ordena as entradas por chave, mantendo a ordem original entre chaves iguais */
+void ordenar_entradas_arvore(EntradaArvore* entradas, size_t total) {
+    qsort(entradas, total, sizeof(EntradaArvore), comparar_entradas);
+}
+
+/* Ordena as entradas uma vez e constroi uma arvore perfeitamente balanceada */
+NoArvore* construir_arvore_balanceada(Arena* arena, EntradaArvore* entradas, size_t total) {
+    ordenar_entradas_arvore(entradas, total);
+    return construir_intervalo(arena, entradas, 0, total);
+}
+
+/* Desce pelo lado esquerdo (ou direito) a partir de no, empilhando o caminho */
+static void descer_extremo(CursorArvore* cursor, NoArvore* no, bool para_direita) {
+    while (no != NULL) {
+        cursor->caminho[cursor->profundidade++] = no;
+        no = para_direita ? no->direita : no->esquerda;
     }
+}
+
+/* Posiciona no menor no (cursor fora da arvore se ela for vazia) */
+void cursor_inicio(CursorArvore* cursor, NoArvore* raiz) {
+    cursor->profundidade = 0;
+    descer_extremo(cursor, raiz, false);
+}
+
+/* Posiciona no maior no */
+void cursor_fim(CursorArvore* cursor, NoArvore* raiz) {
+    cursor->profundidade = 0;
+    descer_extremo(cursor, raiz, true);
+}
+
+/* Posiciona no primeiro no com chave >= chave. Desce guardando o caminho e
+ * a profundidade do ultimo candidato; no fim o caminho e cortado nele. */
+void cursor_buscar(CursorArvore* cursor, NoArvore* raiz, double chave) {
+    int candidato = 0;
+    cursor->profundidade = 0;
+    while (raiz != NULL) {
+        cursor->caminho[cursor->profundidade++] = raiz;
+        if (raiz->chave >= chave) {
+            candidato = cursor->profundidade;
+            raiz = raiz->esquerda;
+        } else {
+            raiz = raiz->direita;
+        }
+    }
+    cursor->profundidade = candidato;
+}
+
+/* Posiciona no ultimo no com chave <= chave (simetrico de cursor_buscar) */
+void cursor_buscar_ate(CursorArvore* cursor, NoArvore* raiz, double chave) {
+    int candidato = 0;
+    cursor->profundidade = 0;
+    while (raiz != NULL) {
+        cursor->caminho[cursor->profundidade++] = raiz;
+        if (raiz->chave <= chave) {
+            candidato = cursor->profundidade;
+            raiz = raiz->direita;
+        } else {
+            raiz = raiz->esquerda;
+        }
+    }
+    cursor->profundidade = candidato;
+}
+
+/* No atual, ou NULL se o cursor saiu da arvore */
+NoArvore* cursor_atual(const CursorArvore* cursor) {
+    return cursor->profundidade > 0 ? cursor->caminho[cursor->profundidade - 1] : NULL;
+}
 
-    if (raiz->chave > min) {
-        percorrer_intervalo(raiz->esquerda, min, max);
+/* Passo em ordem em-ordem. Para frente: se ha subarvore direita, o sucessor
+ * e o menor no dela; senao, sobe ate chegar por um filho esquerdo. Para tras
+ * e o espelho. Sair pela raiz deixa o cursor fora da arvore. */
+static bool cursor_passo(CursorArvore* cursor, bool para_frente) {
+    NoArvore* no = cursor_atual(cursor);
+    if (no == NULL) {
+        return false;
     }
 
-    if (raiz->chave >= min && raiz->chave <= max) {
-        printf("  %3d | %-50s | Energia: %4d kcal | Proteina: %5.1f g\n",
-               raiz->alimento->numero,
-               raiz->alimento->descricao,
-               raiz->alimento->energia_kcal,
-               raiz->alimento->proteina);
+    NoArvore* filho = para_frente ? no->direita : no->esquerda;
+    if (filho != NULL) {
+        cursor->caminho[cursor->profundidade++] = filho;
+        descer_extremo(cursor, para_frente ? filho->esquerda : filho->direita, !para_frente);
+        return true;
     }
 
-    if (raiz->chave < max) {
-        percorrer_intervalo(raiz->direita, min, max);
+    while (--cursor->profundidade > 0) {
+        NoArvore* pai = cursor->caminho[cursor->profundidade - 1];
+        if ((para_frente ? pai->esquerda : pai->direita) == no) {
+            return true;
+        }
+        no = pai;
     }
+    return false;
 }
 
-/* Libera toda a memoria alocada pela arvore */
-void liberar_arvore(NoArvore* raiz) {
-    if (raiz == NULL) {
-        return;
+/* Avanca para o proximo no em ordem crescente; false ao passar do ultimo */
+bool cursor_proximo(CursorArvore* cursor) {
+    return cursor_passo(cursor, true);
+}
+
+/* Volta para o no anterior (ordem decrescente); false ao passar do primeiro */
+bool cursor_anterior(CursorArvore* cursor) {
+    return cursor_passo(cursor, false);
+}
+
+/* Imprime a linha de um alimento nas listagens por arvore */
+void imprimir_alimento_listagem(const NoAlimento* alimento) {
+    printf("  %3d | %-50s | Energia: %4d kcal | Proteina: %5.1f g\n",
+           alimento->numero,
+           alimento->descricao,
+           alimento->energia_kcal,
+           alimento->proteina);
+}
+
+/* Percorre a arvore em ordem decrescente, com um cursor (sem recursao) */
+void percorrer_decrescente(NoArvore* raiz) {
+    CursorArvore cursor;
+    for (cursor_fim(&cursor, raiz); cursor_atual(&cursor) != NULL; cursor_anterior(&cursor)) {
+        imprimir_alimento_listagem(cursor_atual(&cursor)->alimento);
     }
+}
 
-    liberar_arvore(raiz->esquerda);
-    liberar_arvore(raiz->direita);
-    free(raiz);
+/* Percorre a arvore buscando valores em um intervalo [min, max]: o cursor
+ * comeca no primeiro no >= min e avanca ate passar de max */
+void percorrer_intervalo(NoArvore* raiz, double min, double max) {
+    CursorArvore cursor;
+    for (cursor_buscar(&cursor, raiz, min);
+         cursor_atual(&cursor) != NULL && cursor_atual(&cursor)->chave <= max;
+         cursor_proximo(&cursor)) {
+        imprimir_alimento_listagem(cursor_atual(&cursor)->alimento);
+    }
 }
 
-/* Funcao auxiliar para encontrar o menor no (mais a esquerda) */
-static NoArvore* encontrar_minimo(NoArvore* raiz) {
-    NoArvore* atual = raiz;
-    while (atual != NULL && atual->esquerda != NULL) {
-        atual = atual->esquerda;
+/* Menor no da arvore (mais a esquerda), NULL se vazia */
+NoArvore* menor_no_arvore(NoArvore* raiz) {
+    while (raiz != NULL && raiz->esquerda != NULL) {
+        raiz = raiz->esquerda;
     }
-    return atual;
+    return raiz;
 }
 
-/* Remove um alimento especifico da arvore e retorna a nova raiz */
-NoArvore* remover_da_arvore(NoArvore* raiz, NoAlimento* alimento) {
-    if (raiz == NULL) {
-        return NULL;
+/* Maior no da arvore (mais a direita), NULL se vazia */
+NoArvore* maior_no_arvore(NoArvore* raiz) {
+    while (raiz != NULL && raiz->direita != NULL) {
+        raiz = raiz->direita;
     }
+    return raiz;
+}
 
-    if (raiz->alimento == alimento) {
-        /* Caso 1: No sem filhos */
-        if (raiz->esquerda == NULL && raiz->direita == NULL) {
-            free(raiz);
-            return NULL;
+/* Posto da chave: quantos nos tem chave menor. Desce um unico caminho: como
+ * esquerda <= no <= direita, um no menor que a chave leva a subarvore
+ * esquerda inteira junto, e um no maior ou igual exclui a direita. */
+size_t contar_menores_arvore(const NoArvore* raiz, double chave) {
+    size_t total = 0;
+    while (raiz != NULL) {
+        if (raiz->chave < chave) {
+            total += tamanho_arvore(raiz->esquerda) + 1;
+            raiz = raiz->direita;
+        } else {
+            raiz = raiz->esquerda;
         }
+    }
+    return total;
+}
 
-        /* Caso 2: No com apenas um filho */
-        if (raiz->esquerda == NULL) {
-            NoArvore* temp = raiz->direita;
-            free(raiz);
-            return temp;
+/* Quantos nos tem chave menor ou igual a chave (mesmo caminho unico) */
+size_t contar_ate_arvore(const NoArvore* raiz, double chave) {
+    size_t total = 0;
+    while (raiz != NULL) {
+        if (raiz->chave <= chave) {
+            total += tamanho_arvore(raiz->esquerda) + 1;
+            raiz = raiz->direita;
+        } else {
+            raiz = raiz->esquerda;
         }
-        if (raiz->direita == NULL) {
-            NoArvore* temp = raiz->esquerda;
-            free(raiz);
-            return temp;
+    }
+    return total;
+}
+
+/* Quantidade de nos com chave em [min, max], em O(log n) */
+size_t contar_intervalo_arvore(const NoArvore* raiz, double min, double max) {
+    if (min > max) {
+        return 0;
+    }
+    return contar_ate_arvore(raiz, max) - contar_menores_arvore(raiz, min);
+}
+
+/* Quantidade de nos com a chave dada */
+size_t contar_chave_arvore(const NoArvore* raiz, double chave) {
+    return contar_intervalo_arvore(raiz, chave, chave);
+}
+
+/* k-esimo no em ordem crescente (k a partir de 0), ou NULL se k >= tamanho.
+ * Entre chaves iguais vale a ordem em-ordem da arvore. */
+NoArvore* selecionar_arvore(NoArvore* raiz, size_t k) {
+    while (raiz != NULL) {
+        size_t esquerda = tamanho_arvore(raiz->esquerda);
+        if (k < esquerda) {
+            raiz = raiz->esquerda;
+        } else if (k == esquerda) {
+            return raiz;
+        } else {
+            k -= esquerda + 1;
+            raiz = raiz->direita;
         }
+    }
+    return NULL;
+}
 
-        /* Caso 3: No com dois filhos */
-        NoArvore* sucessor = encontrar_minimo(raiz->direita);
-        raiz->chave = sucessor->chave;
-        raiz->alimento = sucessor->alimento;
-        raiz->direita = remover_da_arvore(raiz->direita, sucessor->alimento);
-        return raiz;
+/* Desliga o menor no (mais a esquerda) da subarvore, guardando-o em *minimo */
+static NoArvore* desligar_minimo(NoArvore* raiz, NoArvore** minimo) {
+    if (raiz->esquerda == NULL) {
+        *minimo = raiz;
+        return raiz->direita;
     }
+    raiz->esquerda = desligar_minimo(raiz->esquerda, minimo);
+    return balancear(raiz);
+}
 
-    raiz->esquerda = remover_da_arvore(raiz->esquerda, alimento);
-    raiz->direita = remover_da_arvore(raiz->direita, alimento);
-    return raiz;
+/* Retira um no da arvore, colocando o sucessor em seu lugar quando ha dois filhos.
+ * O no retirado pertence a arena e nao e liberado aqui. */
+static NoArvore* retirar_no(NoArvore* raiz) {
+    /* Caso 1 e 2: No sem filhos ou com apenas um filho */
+    if (raiz->esquerda == NULL || raiz->direita == NULL) {
+        return raiz->esquerda != NULL ? raiz->esquerda : raiz->direita;
+    }
+
+    /* Caso 3: No com dois filhos: o sucessor ocupa o lugar do no */
+    NoArvore* sucessor;
+    NoArvore* direita = desligar_minimo(raiz->direita, &sucessor);
+    sucessor->esquerda = raiz->esquerda;
+    sucessor->direita = direita;
+    return balancear(sucessor);
+}
+
+/* Remove o no (chave, alimento) da subarvore; *removido indica se ele foi achado */
+static NoArvore* remover_por_chave(NoArvore* raiz, double chave, NoAlimento* alimento, bool* removido) {
+    if (raiz == NULL) {
+        return NULL;
+    }
+
+    if (chave < raiz->chave) {
+        raiz->esquerda = remover_por_chave(raiz->esquerda, chave, alimento, removido);
+    } else if (chave > raiz->chave) {
+        raiz->direita = remover_por_chave(raiz->direita, chave, alimento, removido);
+    } else if (raiz->alimento == alimento) {
+        *removido = true;
+        return retirar_no(raiz);
+    } else if (alimento->linha < raiz->alimento->linha) {
+        /* Chave repetida: nas arvores da base as iguais seguem a ordem das linhas */
+        raiz->esquerda = remover_por_chave(raiz->esquerda, chave, alimento, removido);
+    } else if (alimento->linha > raiz->alimento->linha) {
+        raiz->direita = remover_por_chave(raiz->direita, chave, alimento, removido);
+    } else {
+        /* Mesma linha (arvore fora da base): as iguais podem estar dos dois lados */
+        raiz->esquerda = remover_por_chave(raiz->esquerda, chave, alimento, removido);
+        if (!*removido) {
+            raiz->direita = remover_por_chave(raiz->direita, chave, alimento, removido);
+        }
+    }
+
+    return *removido ? balancear(raiz) : raiz;
+}
+
+/* Remove um alimento da arvore, rebalanceando, e retorna a nova raiz.
+ * Custa O(log n) quando as chaves iguais estao na ordem das linhas da
+ * tabela (como nas arvores montadas pelos indices); senao soma o numero
+ * de chaves iguais a removida. */
+NoArvore* remover_da_arvore(NoArvore* raiz, double chave, NoAlimento* alimento) {
+    bool removido = false;
+    return remover_por_chave(raiz, chave, alimento, &removido);
 }
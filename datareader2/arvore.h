@@ -3,11 +3,65 @@
 
 #include "tipos.h"
 
-/* Cria um novo no de arvore binaria */
-NoArvore* criar_no_arvore(double chave, NoAlimento* alimento);
+/* Entrada para a construcao em lote: a posicao desempata chaves iguais,
+ * mantendo a ordem original (a mesma da insercao um a um) */
+typedef struct {
+    double chave;
+    NoAlimento* alimento;
+    size_t posicao;
+} EntradaArvore;
 
-/* Insere um no na arvore binaria mantendo a propriedade de BST */
-NoArvore* inserir_na_arvore(NoArvore* raiz, double chave, NoAlimento* alimento);
+/* Cria um novo no de arvore binaria na arena */
+NoArvore* criar_no_arvore(Arena* arena, double chave, NoAlimento* alimento);
+
+/* Insere um no na arvore mantendo a propriedade de BST e o balanceamento AVL.
+ * Chaves iguais vao para a direita, preservando a ordem de insercao. */
+NoArvore* inserir_na_arvore(Arena* arena, NoArvore* raiz, double chave, NoAlimento* alimento);
+
+/* Ordena as entradas por chave, mantendo a ordem original entre chaves iguais */
+void ordenar_entradas_arvore(EntradaArvore* entradas, size_t total);
+
+/* Ordena as entradas uma vez e constroi uma arvore perfeitamente balanceada.
+ * Chaves iguais podem ficar dos dois lados de um no (esquerda <= no <= direita). */
+NoArvore* construir_arvore_balanceada(Arena* arena, EntradaArvore* entradas, size_t total);
+
+/* Altura maxima de uma arvore AVL (com ate 2^64 nos a altura fica abaixo de 93) */
+#define ALTURA_MAXIMA_ARVORE 96
+
+/* Cursor sobre uma arvore, sem recursao: guarda o caminho da raiz ate o no
+ * atual numa pilha explicita e anda nos dois sentidos da ordem em-ordem.
+ * Uso tipico:
+ *   for (cursor_buscar(&c, raiz, min); cursor_atual(&c) != NULL; cursor_proximo(&c)) ...
+ *   for (cursor_fim(&c, raiz); cursor_atual(&c) != NULL; cursor_anterior(&c)) ...
+ * O cursor fica invalido se a arvore for alterada. */
+typedef struct {
+    NoArvore* caminho[ALTURA_MAXIMA_ARVORE];
+    int profundidade;              /* nos no caminho; 0 = fora da arvore */
+} CursorArvore;
+
+/* Posiciona no menor no (cursor fora da arvore se ela for vazia) */
+void cursor_inicio(CursorArvore* cursor, NoArvore* raiz);
+
+/* Posiciona no maior no */
+void cursor_fim(CursorArvore* cursor, NoArvore* raiz);
+
+/* Posiciona no primeiro no com chave >= chave (para andar em ordem crescente) */
+void cursor_buscar(CursorArvore* cursor, NoArvore* raiz, double chave);
+
+/* Posiciona no ultimo no com chave <= chave (para andar em ordem decrescente) */
+void cursor_buscar_ate(CursorArvore* cursor, NoArvore* raiz, double chave);
+
+/* No atual, ou NULL se o cursor saiu da arvore */
+NoArvore* cursor_atual(const CursorArvore* cursor);
+
+/* Avanca para o proximo no em ordem crescente; false ao passar do ultimo */
+bool cursor_proximo(CursorArvore* cursor);
+
+/* Volta para o no anterior (ordem decrescente); false ao passar do primeiro */
+bool cursor_anterior(CursorArvore* cursor);
+
+/* Imprime a linha de um alimento nas listagens (Num | Descricao | Energia | Proteina) */
+void imprimir_alimento_listagem(const NoAlimento* alimento);
 
 /* Percorre a arvore em ordem decrescente (direita-raiz-esquerda) */
 void percorrer_decrescente(NoArvore* raiz);
@@ -15,10 +69,28 @@ void percorrer_decrescente(NoArvore* raiz);
 /* Percorre a arvore buscando valores em um intervalo [min, max] */
 void percorrer_intervalo(NoArvore* raiz, double min, double max);
 
-/* Libera toda a memoria alocada pela arvore */
-void liberar_arvore(NoArvore* raiz);
+/* Menor e maior no da arvore (NULL se vazia) */
+NoArvore* menor_no_arvore(NoArvore* raiz);
+NoArvore* maior_no_arvore(NoArvore* raiz);
+
+/* Quantidade de nos da subarvore (0 para vazia) */
+size_t tamanho_arvore(const NoArvore* raiz);
+
+/* Consultas de ordem em O(log n), pelos tamanhos das subarvores:
+ * posto (chaves menores), chaves ate um valor, chaves em [min, max] e
+ * chaves iguais a um valor */
+size_t contar_menores_arvore(const NoArvore* raiz, double chave);
+size_t contar_ate_arvore(const NoArvore* raiz, double chave);
+size_t contar_intervalo_arvore(const NoArvore* raiz, double min, double max);
+size_t contar_chave_arvore(const NoArvore* raiz, double chave);
+
+/* k-esimo no em ordem crescente (k a partir de 0), ou NULL se k >= tamanho */
+NoArvore* selecionar_arvore(NoArvore* raiz, size_t k);
 
-/* Remove um alimento especifico da arvore e retorna a nova raiz */
-NoArvore* remover_da_arvore(NoArvore* raiz, NoAlimento* alimento);
+/* Remove um alimento da arvore, rebalanceando, e retorna a nova raiz.
+ * A busca desce pela chave e, entre chaves iguais, pela linha do alimento
+ * na tabela (as arvores dos indices ficam nessa ordem), em O(log n).
+ * O no removido continua na arena ate ela ser liberada. */
+NoArvore* remover_da_arvore(NoArvore* raiz, double chave, NoAlimento* alimento);
 
 #endif
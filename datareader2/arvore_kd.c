@@ -0,0 +1,236 @@
+#include "arvore_kd.h"
+#include "tabela.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Caixa alinhada aos eixos: uma faixa fechada por nutriente */
+typedef struct {
+    double min[TOTAL_NUTRIENTES];
+    double max[TOTAL_NUTRIENTES];
+} CaixaKD;
+
+static void trocar_pontos(PontoKD* a, PontoKD* b) {
+    PontoKD temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+/* Particao de Hoare de [esq, dir] pela dimensao, com o pivo no meio.
+ * Retorna j: [esq, j] fica <= pivo e [j + 1, dir] fica >= pivo. */
+static size_t particionar_pontos(PontoKD* pontos, size_t esq, size_t dir, int dimensao) {
+    double pivo = pontos[esq + (dir - esq) / 2].valores[dimensao];
+    size_t i = esq - 1;
+    size_t j = dir + 1;
+
+    for (;;) {
+        do {
+            i++;
+        } while (pontos[i].valores[dimensao] < pivo);
+        do {
+            j--;
+        } while (pontos[j].valores[dimensao] > pivo);
+        if (i >= j) {
+            return j;
+        }
+        trocar_pontos(&pontos[i], &pontos[j]);
+    }
+}
+
+/* Coloca em pontos[k] o ponto que ficaria ali se [esq, dir] fosse ordenada
+ * pela dimensao, com os menores ou iguais antes e os maiores ou iguais
+ * depois (selecao rapida, O(n) em media) */
+static void selecionar_ponto(PontoKD* pontos, size_t esq, size_t dir, size_t k, int dimensao) {
+    while (esq < dir) {
+        size_t j = particionar_pontos(pontos, esq, dir, dimensao);
+        if (k <= j) {
+            dir = j;
+        } else {
+            esq = j + 1;
+        }
+    }
+}
+
+/* Dimensao de maior amplitude entre os pontos de [inicio, fim) */
+static int dimensao_mais_larga(const PontoKD* pontos, size_t inicio, size_t fim) {
+    CaixaKD caixa;
+    for (int d = 0; d < TOTAL_NUTRIENTES; d++) {
+        caixa.min[d] = pontos[inicio].valores[d];
+        caixa.max[d] = pontos[inicio].valores[d];
+    }
+    for (size_t i = inicio + 1; i < fim; i++) {
+        for (int d = 0; d < TOTAL_NUTRIENTES; d++) {
+            double v = pontos[i].valores[d];
+            if (v < caixa.min[d]) {
+                caixa.min[d] = v;
+            } else if (v > caixa.max[d]) {
+                caixa.max[d] = v;
+            }
+        }
+    }
+
+    int melhor = 0;
+    for (int d = 1; d < TOTAL_NUTRIENTES; d++) {
+        if (caixa.max[d] - caixa.min[d] > caixa.max[melhor] - caixa.min[melhor]) {
+            melhor = d;
+        }
+    }
+    return melhor;
+}
+
+/* Monta a subarvore de [inicio, fim): a mediana da dimensao mais larga vai
+ * para o meio e as duas metades sao montadas do mesmo jeito */
+static void montar_subarvore(ArvoreKD* arvore, size_t inicio, size_t fim) {
+    if (fim - inicio <= BALDE_KD) {
+        return;
+    }
+
+    int dimensao = dimensao_mais_larga(arvore->pontos, inicio, fim);
+    size_t meio = inicio + (fim - inicio) / 2;
+    selecionar_ponto(arvore->pontos, inicio, fim - 1, meio, dimensao);
+    arvore->dimensao[meio] = (unsigned char)dimensao;
+
+    montar_subarvore(arvore, inicio, meio);
+    montar_subarvore(arvore, meio + 1, fim);
+}
+
+/* Constroi a arvore com as linhas presentes da tabela, em O(n log n).
+ * Retorna false se faltar memoria. */
+bool construir_arvore_kd(ArvoreKD* arvore, const TabelaAlimentos* tabela) {
+    memset(arvore, 0, sizeof(ArvoreKD));
+
+    size_t total = tabela->presentes;
+    arvore->pontos = (PontoKD*)malloc((total > 0 ? total : 1) * sizeof(PontoKD));
+    arvore->dimensao = (unsigned char*)malloc(total > 0 ? total : 1);
+    if (arvore->pontos == NULL || arvore->dimensao == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para a arvore k-d.\n");
+        liberar_arvore_kd(arvore);
+        return false;
+    }
+
+    for (size_t linha = 0; linha < tabela->total; linha++) {
+        if (!linha_presente(tabela, linha)) {
+            continue;
+        }
+        PontoKD* ponto = &arvore->pontos[arvore->total++];
+        ponto->valores[COLUNA_UMIDADE] = tabela->umidade[linha];
+        ponto->valores[COLUNA_ENERGIA] = (double)tabela->energia_kcal[linha];
+        ponto->valores[COLUNA_PROTEINA] = tabela->proteina[linha];
+        ponto->valores[COLUNA_CARBOIDRATO] = tabela->carboidrato[linha];
+        ponto->linha = linha;
+    }
+
+    montar_subarvore(arvore, 0, arvore->total);
+    return true;
+}
+
+/* Indica se o ponto esta dentro da caixa */
+static bool ponto_na_caixa(const PontoKD* ponto, const CaixaKD* caixa) {
+    for (int d = 0; d < TOTAL_NUTRIENTES; d++) {
+        if (!(ponto->valores[d] >= caixa->min[d] && ponto->valores[d] <= caixa->max[d])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Indica se a celula esta inteira dentro da consulta */
+static bool celula_contida(const CaixaKD* celula, const CaixaKD* consulta) {
+    for (int d = 0; d < TOTAL_NUTRIENTES; d++) {
+        if (celula->min[d] < consulta->min[d] || celula->max[d] > consulta->max[d]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Marca a linha do ponto se ela ainda estiver presente; retorna 1 se marcou */
+static size_t marcar_ponto(const PontoKD* ponto, const TabelaAlimentos* tabela, uint64_t* selecao) {
+    size_t linha = ponto->linha;
+    if (!linha_presente(tabela, linha)) {
+        return 0;
+    }
+    marcar_linha(selecao, linha);
+    return 1;
+}
+
+/* Visita a subarvore de [inicio, fim), cujos pontos estao todos na celula */
+static size_t visitar_subarvore(const ArvoreKD* arvore, const TabelaAlimentos* tabela, const CaixaKD* consulta,
+                                const CaixaKD* celula, size_t inicio, size_t fim, uint64_t* selecao) {
+    size_t marcados = 0;
+
+    if (celula_contida(celula, consulta)) {
+        for (size_t i = inicio; i < fim; i++) {
+            marcados += marcar_ponto(&arvore->pontos[i], tabela, selecao);
+        }
+        return marcados;
+    }
+
+    if (fim - inicio <= BALDE_KD) {
+        for (size_t i = inicio; i < fim; i++) {
+            if (ponto_na_caixa(&arvore->pontos[i], consulta)) {
+                marcados += marcar_ponto(&arvore->pontos[i], tabela, selecao);
+            }
+        }
+        return marcados;
+    }
+
+    size_t meio = inicio + (fim - inicio) / 2;
+    int dimensao = arvore->dimensao[meio];
+    double corte = arvore->pontos[meio].valores[dimensao];
+
+    if (ponto_na_caixa(&arvore->pontos[meio], consulta)) {
+        marcados += marcar_ponto(&arvore->pontos[meio], tabela, selecao);
+    }
+    if (consulta->min[dimensao] <= corte) {
+        CaixaKD esquerda = *celula;
+        esquerda.max[dimensao] = corte;
+        marcados += visitar_subarvore(arvore, tabela, consulta, &esquerda, inicio, meio, selecao);
+    }
+    if (consulta->max[dimensao] >= corte) {
+        CaixaKD direita = *celula;
+        direita.min[dimensao] = corte;
+        marcados += visitar_subarvore(arvore, tabela, consulta, &direita, meio + 1, fim, selecao);
+    }
+    return marcados;
+}
+
+/* Marca em selecao as linhas presentes dentro da caixa dos filtros e
+ * retorna quantas marcou. Filtros na mesma coluna sao intersectados. */
+size_t consultar_caixa_kd(const ArvoreKD* arvore, const TabelaAlimentos* tabela,
+                          const FiltroIntervalo* filtros, size_t total_filtros, uint64_t* selecao) {
+    memset(selecao, 0, palavras_selecao(tabela->total) * sizeof(uint64_t));
+
+    CaixaKD consulta;
+    CaixaKD celula;
+    for (int d = 0; d < TOTAL_NUTRIENTES; d++) {
+        consulta.min[d] = -INFINITY;
+        consulta.max[d] = INFINITY;
+        celula.min[d] = -INFINITY;
+        celula.max[d] = INFINITY;
+    }
+    for (size_t i = 0; i < total_filtros; i++) {
+        int d = filtros[i].coluna;
+        if (filtros[i].min > consulta.min[d]) {
+            consulta.min[d] = filtros[i].min;
+        }
+        if (filtros[i].max < consulta.max[d]) {
+            consulta.max[d] = filtros[i].max;
+        }
+    }
+
+    if (arvore->total == 0) {
+        return 0;
+    }
+    return visitar_subarvore(arvore, tabela, &consulta, &celula, 0, arvore->total, selecao);
+}
+
+/* Libera os pontos da arvore */
+void liberar_arvore_kd(ArvoreKD* arvore) {
+    free(arvore->pontos);
+    free(arvore->dimensao);
+    arvore->pontos = NULL;
+    arvore->dimensao = NULL;
+    arvore->total = 0;
+}
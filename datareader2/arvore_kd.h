@@ -0,0 +1,31 @@
+#ifndef ARVORE_KD_H
+#define ARVORE_KD_H
+
+#include "tipos.h"
+#include "filtro.h"
+
+/* Arvore k-d sobre o vetor (umidade, energia, proteina, carboidrato) de
+ * cada alimento, para consultas de caixa (uma faixa por nutriente) sem
+ * varrer a tabela. E montada de uma vez a partir da tabela; linhas
+ * removidas depois continuam na arvore e sao ignoradas nas consultas. */
+
+/* Pontos por folha: faixas com ate esse tamanho sao varridas direto */
+#define BALDE_KD 8
+
+/* Constroi a arvore com as linhas presentes da tabela.
+ * Retorna false se faltar memoria. */
+bool construir_arvore_kd(ArvoreKD* arvore, const TabelaAlimentos* tabela);
+
+/* Marca em selecao (palavras_selecao(tabela->total) palavras, ver filtro.h)
+ * as linhas presentes dentro da caixa dada pela conjuncao dos filtros
+ * (nutrientes sem filtro ficam livres) e retorna quantas marcou.
+ * Subarvores fora da caixa sao podadas e as inteiramente dentro sao
+ * marcadas sem comparar. Compensa em caixas seletivas; se a caixa pega
+ * boa parte da tabela, a varredura vetorizada (filtrar_tabela) e mais rapida. */
+size_t consultar_caixa_kd(const ArvoreKD* arvore, const TabelaAlimentos* tabela,
+                          const FiltroIntervalo* filtros, size_t total_filtros, uint64_t* selecao);
+
+/* Libera os pontos da arvore */
+void liberar_arvore_kd(ArvoreKD* arvore);
+
+#endif
@@ -0,0 +1,163 @@
+/* Benchmark: arvore AVL (insercao um a um e construcao em lote) contra o
+ * indice plano em ordem de Eytzinger, em consultas de intervalo.
+ * Uso: ./bench_indices [quantidade_de_alimentos] [quantidade_de_consultas] */
+#include "arena.h"
+#include "arvore.h"
+#include "indice_plano.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LARGURA_INTERVALO 0.01
+
+/* Gerador pseudo-aleatorio simples (xorshift), reprodutivel entre plataformas */
+static unsigned long long estado = 88172645463325252ULL;
+static unsigned long long proximo_aleatorio(void) {
+    estado ^= estado << 13;
+    estado ^= estado >> 7;
+    estado ^= estado << 17;
+    return estado;
+}
+
+/* Conta os nos da arvore com chave em [min, max] visitando cada um
+ * (contar_intervalo_arvore faz o mesmo pelos tamanhos, em O(log n)) */
+static size_t varrer_intervalo_arvore(const NoArvore* raiz, double min, double max) {
+    size_t total = 0;
+    while (raiz != NULL) {
+        if (raiz->chave < min) {
+            raiz = raiz->direita;
+        } else if (raiz->chave > max) {
+            raiz = raiz->esquerda;
+        } else {
+            total += 1 + varrer_intervalo_arvore(raiz->esquerda, min, max);
+            raiz = raiz->direita;
+        }
+    }
+    return total;
+}
+
+/* Conta as chaves do indice plano em [min, max] */
+static size_t contar_intervalo_plano(const IndicePlano* indice, double min, double max) {
+    size_t inicio = limite_inferior_plano(indice, min);
+    size_t fim = inicio;
+    while (fim < indice->total && indice->chaves[fim] <= max) {
+        fim++;
+    }
+    return fim - inicio;
+}
+
+/* Tempo em milissegundos desde um instante */
+static double milissegundos(clock_t inicio) {
+    return 1000.0 * (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1000000;
+    size_t consultas = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 200000;
+    if (total == 0) {
+        total = 1;
+    }
+
+    NoAlimento* alimentos = (NoAlimento*)calloc(total, sizeof(NoAlimento));
+    EntradaArvore* entradas = (EntradaArvore*)malloc(total * sizeof(EntradaArvore));
+    double* limites = (double*)malloc(consultas * sizeof(double));
+    if (alimentos == NULL || entradas == NULL || limites == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para o benchmark.\n");
+        return 1;
+    }
+
+    /* Chaves no estilo da proteina: 0 a 100 g com quatro casas decimais */
+    for (size_t i = 0; i < total; i++) {
+        alimentos[i].numero = (int)i;
+        alimentos[i].proteina = (double)(proximo_aleatorio() % 1000000) / 10000.0;
+    }
+    for (size_t q = 0; q < consultas; q++) {
+        limites[q] = (double)(proximo_aleatorio() % 1000000) / 10000.0;
+    }
+
+    printf("Alimentos: %lu | Consultas: %lu (intervalos [x, x+0.01])\n\n",
+           (unsigned long)total, (unsigned long)consultas);
+    printf("%-28s | %12s | %12s | %12s\n", "Indice", "Construcao", "Consultas", "Resultados");
+    printf("-----------------------------+--------------+--------------+-------------\n");
+
+    /* Arvore AVL, insercao um a um */
+    Arena arena;
+    inicializar_arena(&arena, total * sizeof(NoArvore));
+    clock_t inicio = clock();
+    NoArvore* avl = NULL;
+    for (size_t i = 0; i < total; i++) {
+        avl = inserir_na_arvore(&arena, avl, alimentos[i].proteina, &alimentos[i]);
+    }
+    double construcao = milissegundos(inicio);
+    inicio = clock();
+    size_t encontrados = 0;
+    for (size_t q = 0; q < consultas; q++) {
+        encontrados += varrer_intervalo_arvore(avl, limites[q], limites[q] + LARGURA_INTERVALO);
+    }
+    printf("%-28s | %9.1f ms | %9.1f ms | %12lu\n", "AVL (insercao)", construcao,
+           milissegundos(inicio), (unsigned long)encontrados);
+    liberar_arena(&arena);
+
+    /* Arvore construida em lote */
+    for (size_t i = 0; i < total; i++) {
+        entradas[i].chave = alimentos[i].proteina;
+        entradas[i].alimento = &alimentos[i];
+        entradas[i].posicao = i;
+    }
+    inicializar_arena(&arena, total * sizeof(NoArvore));
+    inicio = clock();
+    NoArvore* lote = construir_arvore_balanceada(&arena, entradas, total);
+    construcao = milissegundos(inicio);
+    inicio = clock();
+    encontrados = 0;
+    for (size_t q = 0; q < consultas; q++) {
+        encontrados += varrer_intervalo_arvore(lote, limites[q], limites[q] + LARGURA_INTERVALO);
+    }
+    printf("%-28s | %9.1f ms | %9.1f ms | %12lu\n", "Arvore em lote", construcao,
+           milissegundos(inicio), (unsigned long)encontrados);
+
+    /* Mesma arvore, contando pelos tamanhos das subarvores (sem visitar os nos) */
+    inicio = clock();
+    encontrados = 0;
+    for (size_t q = 0; q < consultas; q++) {
+        encontrados += contar_intervalo_arvore(lote, limites[q], limites[q] + LARGURA_INTERVALO);
+    }
+    printf("%-28s | %12s | %9.1f ms | %12lu\n", "  contagem por tamanhos", "-",
+           milissegundos(inicio), (unsigned long)encontrados);
+    liberar_arena(&arena);
+
+    /* Indice plano (Eytzinger + varredura) */
+    for (size_t i = 0; i < total; i++) {
+        entradas[i].chave = alimentos[i].proteina;
+        entradas[i].alimento = &alimentos[i];
+        entradas[i].posicao = i;
+    }
+    IndicePlano plano;
+    inicio = clock();
+    if (!construir_indice_plano(&plano, entradas, total)) {
+        return 1;
+    }
+    construcao = milissegundos(inicio);
+    inicio = clock();
+    encontrados = 0;
+    for (size_t q = 0; q < consultas; q++) {
+        encontrados += contar_intervalo_plano(&plano, limites[q], limites[q] + LARGURA_INTERVALO);
+    }
+    printf("%-28s | %9.1f ms | %9.1f ms | %12lu\n", "Indice plano (Eytzinger)", construcao,
+           milissegundos(inicio), (unsigned long)encontrados);
+
+    /* Busca pontual: so o limite inferior, sem varrer o intervalo */
+    inicio = clock();
+    size_t soma = 0;
+    for (size_t q = 0; q < consultas; q++) {
+        soma += limite_inferior_plano(&plano, limites[q]);
+    }
+    printf("%-28s | %12s | %9.1f ms | %12lu\n", "  limite inferior apenas", "-",
+           milissegundos(inicio), (unsigned long)(soma % 1000000));
+    liberar_indice_plano(&plano);
+
+    free(alimentos);
+    free(entradas);
+    free(limites);
+    return 0;
+}
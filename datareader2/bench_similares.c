@@ -0,0 +1,191 @@
+/* Benchmark: busca dos k alimentos mais parecidos pela forca bruta
+ * vetorizada e pela arvore k-d, em tabelas sinteticas de tamanhos
+ * crescentes (a maior com a quantidade pedida). Mostra o custo de cada
+ * caminho usado na escolha de buscar_similares (FATOR_FORCA_BRUTA) e
+ * confere que os dois devolvem os mesmos vizinhos.
+ * Uso: ./bench_similares [quantidade_de_alimentos] [quantidade_de_consultas] [k] */
+#include "agregacao.h"
+#include "arvore_kd.h"
+#include "filtro.h"
+#include "similares.h"
+#include "tabela.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TOTAL_GRUPOS 16
+
+/* Gerador pseudo-aleatorio simples (xorshift), reprodutivel entre plataformas */
+static unsigned long long estado = 88172645463325252ULL;
+static unsigned long long proximo_aleatorio(void) {
+    estado ^= estado << 13;
+    estado ^= estado >> 7;
+    estado ^= estado << 17;
+    return estado;
+}
+
+/* Valor em [0, 1) */
+static double aleatorio_unitario(void) {
+    return (double)(proximo_aleatorio() % 1000000) / 1000000.0;
+}
+
+/* Valor perto do centro, sem passar de [0, maximo] */
+static double perto_de(double centro, double raio, double maximo) {
+    double valor = centro + (2.0 * aleatorio_unitario() - 1.0) * raio;
+    return valor < 0.0 ? 0.0 : (valor > maximo ? maximo : valor);
+}
+
+/* Tempo em milissegundos desde um instante */
+static double milissegundos(clock_t inicio) {
+    return 1000.0 * (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+/* Preenche as colunas com alimentos em grupos (como as categorias reais:
+ * carnes com muita proteina, cereais com muito carboidrato, ...) e todas
+ * as linhas presentes */
+static bool gerar_tabela(TabelaAlimentos* tabela, size_t total) {
+    memset(tabela, 0, sizeof(TabelaAlimentos));
+    tabela->total = total;
+    tabela->presentes = total;
+    tabela->numero = (int*)malloc(total * sizeof(int));
+    tabela->umidade = (double*)malloc(total * sizeof(double));
+    tabela->energia_kcal = (int*)malloc(total * sizeof(int));
+    tabela->proteina = (double*)malloc(total * sizeof(double));
+    tabela->carboidrato = (double*)malloc(total * sizeof(double));
+    tabela->presenca = (uint64_t*)malloc(palavras_selecao(total) * sizeof(uint64_t));
+    if (tabela->numero == NULL || tabela->umidade == NULL || tabela->energia_kcal == NULL ||
+        tabela->proteina == NULL || tabela->carboidrato == NULL || tabela->presenca == NULL) {
+        return false;
+    }
+
+    double centros[TOTAL_GRUPOS][TOTAL_NUTRIENTES];
+    for (int g = 0; g < TOTAL_GRUPOS; g++) {
+        centros[g][COLUNA_UMIDADE] = 100.0 * aleatorio_unitario();
+        centros[g][COLUNA_ENERGIA] = 600.0 * aleatorio_unitario();
+        centros[g][COLUNA_PROTEINA] = 40.0 * aleatorio_unitario();
+        centros[g][COLUNA_CARBOIDRATO] = 80.0 * aleatorio_unitario();
+    }
+    for (size_t i = 0; i < total; i++) {
+        const double* centro = centros[proximo_aleatorio() % TOTAL_GRUPOS];
+        tabela->numero[i] = (int)i + 1;
+        tabela->umidade[i] = perto_de(centro[COLUNA_UMIDADE], 15.0, 100.0);
+        tabela->energia_kcal[i] = (int)perto_de(centro[COLUNA_ENERGIA], 120.0, 900.0);
+        tabela->proteina[i] = perto_de(centro[COLUNA_PROTEINA], 8.0, 90.0);
+        tabela->carboidrato[i] = perto_de(centro[COLUNA_CARBOIDRATO], 15.0, 100.0);
+    }
+    memset(tabela->presenca, 0xFF, palavras_selecao(total) * sizeof(uint64_t));
+    return true;
+}
+
+/* Nutrientes de uma linha como ponto de consulta */
+static void linha_como_consulta(const TabelaAlimentos* tabela, size_t linha, double consulta[TOTAL_NUTRIENTES]) {
+    consulta[COLUNA_UMIDADE] = tabela->umidade[linha];
+    consulta[COLUNA_ENERGIA] = (double)tabela->energia_kcal[linha];
+    consulta[COLUNA_PROTEINA] = tabela->proteina[linha];
+    consulta[COLUNA_CARBOIDRATO] = tabela->carboidrato[linha];
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1000000;
+    size_t consultas = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 200;
+    size_t k = argc > 3 ? (size_t)strtoul(argv[3], NULL, 10) : 10;
+    if (total == 0) {
+        total = 1;
+    }
+    if (consultas == 0) {
+        consultas = 1;
+    }
+    if (k == 0) {
+        k = 1;
+    }
+
+    TabelaAlimentos tabela;
+    Vizinho* bruta = (Vizinho*)malloc(consultas * k * sizeof(Vizinho));
+    Vizinho* kd = (Vizinho*)malloc(consultas * k * sizeof(Vizinho));
+    size_t* achados_bruta = (size_t*)malloc(consultas * sizeof(size_t));
+    size_t* achados_kd = (size_t*)malloc(consultas * sizeof(size_t));
+    size_t* linhas = (size_t*)malloc(consultas * sizeof(size_t));
+    if (!gerar_tabela(&tabela, total) || bruta == NULL || kd == NULL || achados_bruta == NULL ||
+        achados_kd == NULL || linhas == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para o benchmark.\n");
+        return 1;
+    }
+
+    printf("Alimentos: ate %lu | Consultas: %lu | k = %lu | Forca bruta: %s\n\n",
+           (unsigned long)total, (unsigned long)consultas, (unsigned long)k, nivel_simd_similares());
+    printf("%-12s | %14s | %16s | %16s | %8s\n", "Alimentos", "Arvore k-d", "Forca bruta", "Arvore k-d", "Iguais");
+    printf("%-12s | %14s | %16s | %16s | %8s\n", "", "(construcao)", "(por consulta)", "(por consulta)", "");
+    printf("-------------+----------------+------------------+------------------+---------\n");
+
+    /* As tabelas menores sao prefixos da maior; a escala vem de cada uma */
+    size_t tamanho = 1000;
+    for (;;) {
+        if (tamanho > total) {
+            tamanho = total;
+        }
+        TabelaAlimentos prefixo = tabela;
+        prefixo.total = tamanho;
+        prefixo.presentes = tamanho;
+
+        ParticaoTabela inteira = {NULL, 0, tamanho};
+        ResumoCategoria resumo;
+        agregar_particao(&prefixo, &inteira, &resumo);
+        double escala[TOTAL_NUTRIENTES];
+        escala_nutrientes(&resumo, escala);
+
+        ArvoreKD arvore;
+        clock_t inicio = clock();
+        if (!construir_arvore_kd(&arvore, &prefixo)) {
+            return 1;
+        }
+        double construcao = milissegundos(inicio);
+
+        for (size_t q = 0; q < consultas; q++) {
+            linhas[q] = (size_t)(proximo_aleatorio() % tamanho);
+        }
+
+        /* Cada caminho roda todas as consultas de uma vez (o relogio nao
+         * tem resolucao para uma so) e guarda os vizinhos para a conferencia */
+        inicio = clock();
+        for (size_t q = 0; q < consultas; q++) {
+            double consulta[TOTAL_NUTRIENTES];
+            linha_como_consulta(&prefixo, linhas[q], consulta);
+            achados_bruta[q] = vizinhos_forca_bruta(&prefixo, 0, tamanho, consulta, escala, linhas[q], k, bruta + q * k);
+        }
+        double tempo_bruta = milissegundos(inicio);
+
+        inicio = clock();
+        for (size_t q = 0; q < consultas; q++) {
+            double consulta[TOTAL_NUTRIENTES];
+            linha_como_consulta(&prefixo, linhas[q], consulta);
+            achados_kd[q] = vizinhos_arvore_kd(&arvore, &prefixo, NULL, consulta, escala, linhas[q], k, kd + q * k);
+        }
+        double tempo_kd = milissegundos(inicio);
+
+        size_t iguais = 0;
+        for (size_t q = 0; q < consultas; q++) {
+            if (achados_bruta[q] == achados_kd[q] &&
+                memcmp(bruta + q * k, kd + q * k, achados_kd[q] * sizeof(Vizinho)) == 0) {
+                iguais++;
+            }
+        }
+        printf("%-12lu | %11.1f ms | %13.1f us | %13.1f us | %8lu\n", (unsigned long)tamanho, construcao,
+               1000.0 * tempo_bruta / (double)consultas, 1000.0 * tempo_kd / (double)consultas,
+               (unsigned long)iguais);
+        liberar_arvore_kd(&arvore);
+
+        if (tamanho == total) {
+            break;
+        }
+        tamanho *= 4;
+    }
+
+    free(bruta);
+    free(kd);
+    free(achados_bruta);
+    free(achados_kd);
+    free(linhas);
+    liberar_tabela(&tabela);
+    return 0;
+}
@@ -1,61 +1,38 @@
 #include "categoria.h"
-#include "arvore.h"
+#include "agregacao.h"
+#include "arena.h"
+#include "indice_numero.h"
+#include "indices.h"
+#include "registro.h"
+#include "tabela.h"
 #include "utils.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* Cria um novo no de alimento */
-NoAlimento* criar_no_alimento(AlimentoArquivo* alimento_arquivo) {
-    NoAlimento* novo = (NoAlimento*)malloc(sizeof(NoAlimento));
-    if (novo == NULL) {
-        fprintf(stderr, "Erro ao alocar memoria para no de alimento.\n");
-        exit(1);
-    }
-
+/* Preenche um no de alimento a partir de um registro do arquivo mapeado.
+ * A descricao nao e copiada: o no aponta para o texto dentro do mapeamento. */
+void inicializar_no_alimento(NoAlimento* novo, const AlimentoArquivo* alimento_arquivo) {
     novo->numero = alimento_arquivo->numero;
-    strncpy(novo->descricao, alimento_arquivo->descricao, MAX_DESCRICAO - 1);
-    novo->descricao[MAX_DESCRICAO - 1] = '\0';
+    novo->descricao = alimento_arquivo->descricao;
+    novo->tamanho_descricao = (uint32_t)strlen(alimento_arquivo->descricao);
     novo->umidade = alimento_arquivo->umidade;
     novo->energia_kcal = alimento_arquivo->energia_kcal;
     novo->proteina = alimento_arquivo->proteina;
     novo->carboidrato = alimento_arquivo->carboidrato;
-    novo->proximo = NULL;
-
-    return novo;
-}
-
-/* Insere um alimento em ordem alfabetica na lista de alimentos */
-NoAlimento* inserir_alimento_ordenado(NoAlimento* lista, NoAlimento* novo_alimento) {
-    if (lista == NULL || strcmp(novo_alimento->descricao, lista->descricao) < 0) {
-        novo_alimento->proximo = lista;
-        return novo_alimento;
-    }
-
-    NoAlimento* atual = lista;
-    while (atual->proximo != NULL && strcmp(novo_alimento->descricao, atual->proximo->descricao) > 0) {
-        atual = atual->proximo;
-    }
-
-    novo_alimento->proximo = atual->proximo;
-    atual->proximo = novo_alimento;
-    return lista;
+    novo->categoria = NULL;
+    novo->linha = 0;
 }
 
-/* Cria um novo no de categoria */
-NoCategoria* criar_no_categoria(const char* nome) {
-    NoCategoria* nova = (NoCategoria*)malloc(sizeof(NoCategoria));
-    if (nova == NULL) {
-        fprintf(stderr, "Erro ao alocar memoria para no de categoria.\n");
-        exit(1);
-    }
+/* Cria um novo no de categoria na arena */
+NoCategoria* criar_no_categoria(Arena* arena, const char* nome) {
+    NoCategoria* nova = (NoCategoria*)alocar_na_arena(arena, sizeof(NoCategoria));
 
     strncpy(nova->nome, nome, MAX_CATEGORIA - 1);
     nova->nome[MAX_CATEGORIA - 1] = '\0';
     nova->tipo = string_para_categoria(nome);
-    nova->lista_alimentos = NULL;
-    nova->arvore_energia = NULL;
-    nova->arvore_proteina = NULL;
+    nova->particao = 0;
+    memset(nova->indices, 0, sizeof(nova->indices));
     nova->proximo = NULL;
 
     return nova;
@@ -90,69 +67,28 @@ NoCategoria* buscar_categoria(NoCategoria* lista, const char* nome) {
     return NULL;
 }
 
-/* Constroi as arvores binarias de indexacao para uma categoria */
-void construir_arvores_categoria(NoCategoria* categoria) {
-    if (categoria == NULL) {
-        return;
-    }
-
-    NoAlimento* atual = categoria->lista_alimentos;
-    while (atual != NULL) {
-        categoria->arvore_energia = inserir_na_arvore(categoria->arvore_energia,
-                                                      (double)atual->energia_kcal,
-                                                      atual);
-        categoria->arvore_proteina = inserir_na_arvore(categoria->arvore_proteina,
-                                                       atual->proteina,
-                                                       atual);
-        atual = atual->proximo;
-    }
-}
-
-/* Reconstroi as arvores binarias de uma categoria */
-void reconstruir_arvores_categoria(NoCategoria* categoria) {
-    if (categoria == NULL) {
-        return;
-    }
-
-    liberar_arvore(categoria->arvore_energia);
-    liberar_arvore(categoria->arvore_proteina);
-    categoria->arvore_energia = NULL;
-    categoria->arvore_proteina = NULL;
-
-    construir_arvores_categoria(categoria);
+/* Remove da base o alimento com o numero dado, sem precisar da categoria:
+ * o indice por numero leva direto ao no. A linha e marcada como removida
+ * na tabela; os indices e as estatisticas da categoria sao atualizados no
+ * lugar, sem reconstrucao.
+ * Retorna true se ele existia. */
+bool remover_alimento_da_base(BaseDados* base, int numero) {
+    const EntradaNumero* entrada = buscar_indice_numero(&base->numeros, numero);
+    if (entrada == NULL) {
+        return false;
+    }
+
+    NoAlimento* alimento = entrada->alimento;
+    NoCategoria* categoria = entrada->categoria;
+    remover_linha(&base->tabela, alimento->linha);
+    remover_alimento_dos_indices(&base->tabela, &base->indices, categoria, alimento);
+    descontar_estatisticas_categoria(categoria, alimento);
+    remover_indice_numero(&base->numeros, numero);
+    return true;
 }
 
-/* Remove um alimento de uma categoria */
-void remover_alimento_de_categoria(NoCategoria* categoria, int numero_alimento) {
-    if (categoria == NULL || categoria->lista_alimentos == NULL) {
-        return;
-    }
-
-    NoAlimento* atual = categoria->lista_alimentos;
-    NoAlimento* anterior = NULL;
-
-    while (atual != NULL && atual->numero != numero_alimento) {
-        anterior = atual;
-        atual = atual->proximo;
-    }
-
-    if (atual == NULL) {
-        printf("Alimento nao encontrado.\n");
-        return;
-    }
-
-    if (anterior == NULL) {
-        categoria->lista_alimentos = atual->proximo;
-    } else {
-        anterior->proximo = atual->proximo;
-    }
-
-    free(atual);
-    reconstruir_arvores_categoria(categoria);
-    printf("Alimento removido com sucesso.\n");
-}
-
-/* Remove uma categoria da lista e retorna a nova lista */
+/* Remove uma categoria da lista e retorna a nova lista.
+ * O no e suas arvores pertencem a arena da BaseDados. */
 NoCategoria* remover_categoria(NoCategoria* lista, const char* nome) {
     if (lista == NULL) {
         return NULL;
@@ -176,37 +112,37 @@ NoCategoria* remover_categoria(NoCategoria* lista, const char* nome) {
     } else {
         anterior->proximo = atual->proximo;
     }
-
-    liberar_alimentos(atual->lista_alimentos);
-    liberar_arvore(atual->arvore_energia);
-    liberar_arvore(atual->arvore_proteina);
-    free(atual);
+    atual->proximo = NULL;
 
     printf("Categoria removida com sucesso.\n");
     return lista;
 }
 
-/* Libera a memoria de todos os alimentos de uma categoria */
-void liberar_alimentos(NoAlimento* lista) {
-    NoAlimento* atual = lista;
-    while (atual != NULL) {
-        NoAlimento* proximo = atual->proximo;
-        free(atual);
-        atual = proximo;
+/* Remove da base a categoria com o nome dado: retira do registro e da lista,
+ * e tira seus alimentos da tabela, dos indices globais e do indice por numero.
+ * Retorna true se a categoria existia. */
+bool remover_categoria_da_base(BaseDados* base, const char* nome) {
+    NoCategoria* categoria = buscar_categoria_registro(&base->categorias, nome);
+    if (categoria == NULL) {
+        printf("Categoria nao encontrada.\n");
+        return false;
     }
-}
 
-/* Libera a memoria de todas as categorias */
-void liberar_categorias(NoCategoria* lista) {
-    NoCategoria* atual = lista;
-    while (atual != NULL) {
-        NoCategoria* proximo = atual->proximo;
-        liberar_alimentos(atual->lista_alimentos);
-        liberar_arvore(atual->arvore_energia);
-        liberar_arvore(atual->arvore_proteina);
-        free(atual);
-        atual = proximo;
+    TabelaAlimentos* tabela = &base->tabela;
+    remover_categoria_dos_indices(tabela, &base->indices, categoria);
+    ParticaoTabela* particao = &tabela->particoes[categoria->particao];
+    for (size_t linha = proxima_linha(tabela, particao->inicio, particao->fim); linha < particao->fim;
+         linha = proxima_linha(tabela, linha + 1, particao->fim)) {
+        const EntradaNumero* entrada = buscar_indice_numero(&base->numeros, tabela->numero[linha]);
+        if (entrada != NULL && entrada->alimento == tabela->alimento[linha]) {
+            remover_indice_numero(&base->numeros, tabela->numero[linha]);
+        }
+        remover_linha(tabela, linha);
     }
+    particao->categoria = NULL;
+    desregistrar_categoria(&base->categorias, categoria);
+    base->lista_categorias = remover_categoria(base->lista_categorias, categoria->nome);
+    return true;
 }
 
 /* Lista todas as categorias */
@@ -227,14 +163,15 @@ void listar_categorias(NoCategoria* lista) {
     printf("\n");
 }
 
-/* Lista todos os alimentos de uma categoria */
-void listar_alimentos_categoria(NoCategoria* categoria) {
+/* Lista todos os alimentos de uma categoria, varrendo sua particao da tabela */
+void listar_alimentos_categoria(const TabelaAlimentos* tabela, const NoCategoria* categoria) {
     if (categoria == NULL) {
         printf("Categoria nao encontrada.\n");
         return;
     }
 
-    if (categoria->lista_alimentos == NULL) {
+    const ParticaoTabela* particao = particao_categoria(tabela, categoria);
+    if (contar_linhas(tabela, particao->inicio, particao->fim) == 0) {
         printf("Nenhum alimento nesta categoria.\n");
         return;
     }
@@ -243,14 +180,13 @@ void listar_alimentos_categoria(NoCategoria* categoria) {
     printf("  Num | %-50s | Energia | Proteina\n", "Descricao");
     printf("  %s\n", "----------------------------------------------------------------------");
 
-    NoAlimento* atual = categoria->lista_alimentos;
-    while (atual != NULL) {
+    for (size_t linha = proxima_linha(tabela, particao->inicio, particao->fim); linha < particao->fim;
+         linha = proxima_linha(tabela, linha + 1, particao->fim)) {
         printf("  %3d | %-50s | %4d kcal | %5.1f g\n",
-               atual->numero,
-               atual->descricao,
-               atual->energia_kcal,
-               atual->proteina);
-        atual = atual->proximo;
+               tabela->numero[linha],
+               tabela->alimento[linha]->descricao,
+               tabela->energia_kcal[linha],
+               tabela->proteina[linha]);
     }
     printf("\n");
 }
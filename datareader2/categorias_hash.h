@@ -0,0 +1,20 @@
+#ifndef CATEGORIAS_HASH_H
+#define CATEGORIAS_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Hash dos nomes de categoria usado pela tabela perfeita gerada em
+ * tabela_categorias.h. Combina o tamanho com o primeiro, o do meio e o
+ * ultimo byte do nome e espalha por multiplicacao; o resultado tem
+ * 'bits' bits. Exige tamanho >= 1. */
+static inline uint32_t hash_nome_categoria(const char* nome, size_t tamanho,
+                                           uint32_t semente, unsigned bits) {
+    const unsigned char* bytes = (const unsigned char*)nome;
+    uint32_t chave = (uint32_t)tamanho ^ ((uint32_t)bytes[0] << 8) ^
+                     ((uint32_t)bytes[tamanho / 2] << 16) ^
+                     ((uint32_t)bytes[tamanho - 1] << 24);
+    return (chave * semente) >> (32 - bits);
+}
+
+#endif
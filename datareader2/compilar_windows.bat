@@ -47,7 +47,7 @@ echo.
 echo ========================================
 echo Compilando P1.exe...
 echo ========================================
-gcc -Wall -Wextra -std=c99 -o P1.exe P1.c -ljson-c
+gcc -Wall -Wextra -std=c99 -o P1.exe P1.c formato.c texto.c -ljson-c
 if %errorlevel% neq 0 (
     echo [ERRO] Falha ao compilar P1.exe
     pause
@@ -63,9 +63,22 @@ gcc -Wall -Wextra -std=c99 -c utils.c
 gcc -Wall -Wextra -std=c99 -c arvore.c
 gcc -Wall -Wextra -std=c99 -c categoria.c
 gcc -Wall -Wextra -std=c99 -c arquivo.c
+gcc -Wall -Wextra -std=c99 -c formato.c
+gcc -Wall -Wextra -std=c99 -c texto.c
+gcc -Wall -Wextra -std=c99 -c arena.c
+gcc -Wall -Wextra -std=c99 -c registro.c
+gcc -Wall -Wextra -std=c99 -c indice_numero.c
+gcc -Wall -Wextra -std=c99 -c tabela.c
+gcc -Wall -Wextra -std=c99 -c filtro.c
+gcc -Wall -Wextra -std=c99 -c agregacao.c
+gcc -Wall -Wextra -std=c99 -c melhores.c
+gcc -Wall -Wextra -std=c99 -c ordem.c
+gcc -Wall -Wextra -std=c99 -c indices.c
+gcc -Wall -Wextra -std=c99 -c arvore_kd.c
+gcc -Wall -Wextra -std=c99 -c similares.c
 gcc -Wall -Wextra -std=c99 -c menu.c
 gcc -Wall -Wextra -std=c99 -c P2.c
-gcc -Wall -Wextra -std=c99 -o P2.exe P2.o utils.o arvore.o categoria.o arquivo.o menu.o
+gcc -Wall -Wextra -std=c99 -o P2.exe P2.o utils.o arvore.o categoria.o arquivo.o formato.o texto.o arena.o registro.o indice_numero.o tabela.o filtro.o agregacao.o melhores.o ordem.o indices.o arvore_kd.o similares.o menu.o -lm
 if %errorlevel% neq 0 (
     echo [ERRO] Falha ao compilar P2.exe
     pause
@@ -0,0 +1,293 @@
+#include "filtro.h"
+#include "simd.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef void (*NucleoDouble)(const double*, size_t, double, double, uint64_t*);
+typedef void (*NucleoInt)(const int*, size_t, int, int, uint64_t*);
+
+/* Quantidade de palavras de 64 bits de uma selecao com total linhas */
+size_t palavras_selecao(size_t total_linhas) {
+    return (total_linhas + BITS_POR_PALAVRA - 1) / BITS_POR_PALAVRA;
+}
+
+/* Escalar, sem desvios: cada comparacao vira um bit da palavra */
+static uint64_t palavra_double_escalar(const double* valores, size_t quantidade, double min, double max) {
+    uint64_t palavra = 0;
+    for (size_t b = 0; b < quantidade; b++) {
+        palavra |= (uint64_t)((valores[b] >= min) & (valores[b] <= max)) << b;
+    }
+    return palavra;
+}
+
+static uint64_t palavra_int_escalar(const int* valores, size_t quantidade, int min, int max) {
+    uint64_t palavra = 0;
+    for (size_t b = 0; b < quantidade; b++) {
+        palavra |= (uint64_t)((valores[b] >= min) & (valores[b] <= max)) << b;
+    }
+    return palavra;
+}
+
+static void filtrar_double_escalar(const double* coluna, size_t total, double min, double max, uint64_t* selecao) {
+    for (size_t p = 0; p * BITS_POR_PALAVRA < total; p++) {
+        size_t inicio = p * BITS_POR_PALAVRA;
+        size_t quantidade = total - inicio < BITS_POR_PALAVRA ? total - inicio : BITS_POR_PALAVRA;
+        selecao[p] = palavra_double_escalar(coluna + inicio, quantidade, min, max);
+    }
+}
+
+static void filtrar_int_escalar(const int* coluna, size_t total, int min, int max, uint64_t* selecao) {
+    for (size_t p = 0; p * BITS_POR_PALAVRA < total; p++) {
+        size_t inicio = p * BITS_POR_PALAVRA;
+        size_t quantidade = total - inicio < BITS_POR_PALAVRA ? total - inicio : BITS_POR_PALAVRA;
+        selecao[p] = palavra_int_escalar(coluna + inicio, quantidade, min, max);
+    }
+}
+
+#ifdef SIMD_X86
+/* SSE2: 2 doubles ou 4 inteiros por comparacao; a ultima palavra incompleta
+ * fica com o nucleo escalar */
+__attribute__((target("sse2")))
+static void filtrar_double_sse2(const double* coluna, size_t total, double min, double max, uint64_t* selecao) {
+    __m128d vmin = _mm_set1_pd(min);
+    __m128d vmax = _mm_set1_pd(max);
+    size_t completas = total / BITS_POR_PALAVRA;
+    for (size_t p = 0; p < completas; p++) {
+        const double* valores = coluna + p * BITS_POR_PALAVRA;
+        uint64_t palavra = 0;
+        for (size_t b = 0; b < BITS_POR_PALAVRA; b += 2) {
+            __m128d x = _mm_loadu_pd(valores + b);
+            __m128d dentro = _mm_and_pd(_mm_cmpge_pd(x, vmin), _mm_cmple_pd(x, vmax));
+            palavra |= (uint64_t)_mm_movemask_pd(dentro) << b;
+        }
+        selecao[p] = palavra;
+    }
+    if (completas * BITS_POR_PALAVRA < total) {
+        size_t inicio = completas * BITS_POR_PALAVRA;
+        selecao[completas] = palavra_double_escalar(coluna + inicio, total - inicio, min, max);
+    }
+}
+
+__attribute__((target("sse2")))
+static void filtrar_int_sse2(const int* coluna, size_t total, int min, int max, uint64_t* selecao) {
+    __m128i vmin = _mm_set1_epi32(min);
+    __m128i vmax = _mm_set1_epi32(max);
+    size_t completas = total / BITS_POR_PALAVRA;
+    for (size_t p = 0; p < completas; p++) {
+        const int* valores = coluna + p * BITS_POR_PALAVRA;
+        uint64_t palavra = 0;
+        for (size_t b = 0; b < BITS_POR_PALAVRA; b += 4) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(valores + b));
+            /* fora = min > x ou x > max; dentro e o complemento */
+            __m128i fora = _mm_or_si128(_mm_cmpgt_epi32(vmin, x), _mm_cmpgt_epi32(x, vmax));
+            palavra |= (uint64_t)(~_mm_movemask_ps(_mm_castsi128_ps(fora)) & 0xF) << b;
+        }
+        selecao[p] = palavra;
+    }
+    if (completas * BITS_POR_PALAVRA < total) {
+        size_t inicio = completas * BITS_POR_PALAVRA;
+        selecao[completas] = palavra_int_escalar(coluna + inicio, total - inicio, min, max);
+    }
+}
+
+/* AVX2: 4 doubles ou 8 inteiros por comparacao */
+__attribute__((target("avx2")))
+static void filtrar_double_avx2(const double* coluna, size_t total, double min, double max, uint64_t* selecao) {
+    __m256d vmin = _mm256_set1_pd(min);
+    __m256d vmax = _mm256_set1_pd(max);
+    size_t completas = total / BITS_POR_PALAVRA;
+    for (size_t p = 0; p < completas; p++) {
+        const double* valores = coluna + p * BITS_POR_PALAVRA;
+        uint64_t palavra = 0;
+        for (size_t b = 0; b < BITS_POR_PALAVRA; b += 4) {
+            __m256d x = _mm256_loadu_pd(valores + b);
+            __m256d dentro = _mm256_and_pd(_mm256_cmp_pd(x, vmin, _CMP_GE_OQ),
+                                           _mm256_cmp_pd(x, vmax, _CMP_LE_OQ));
+            palavra |= (uint64_t)_mm256_movemask_pd(dentro) << b;
+        }
+        selecao[p] = palavra;
+    }
+    if (completas * BITS_POR_PALAVRA < total) {
+        size_t inicio = completas * BITS_POR_PALAVRA;
+        selecao[completas] = palavra_double_escalar(coluna + inicio, total - inicio, min, max);
+    }
+}
+
+__attribute__((target("avx2")))
+static void filtrar_int_avx2(const int* coluna, size_t total, int min, int max, uint64_t* selecao) {
+    __m256i vmin = _mm256_set1_epi32(min);
+    __m256i vmax = _mm256_set1_epi32(max);
+    size_t completas = total / BITS_POR_PALAVRA;
+    for (size_t p = 0; p < completas; p++) {
+        const int* valores = coluna + p * BITS_POR_PALAVRA;
+        uint64_t palavra = 0;
+        for (size_t b = 0; b < BITS_POR_PALAVRA; b += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(valores + b));
+            __m256i fora = _mm256_or_si256(_mm256_cmpgt_epi32(vmin, x), _mm256_cmpgt_epi32(x, vmax));
+            palavra |= (uint64_t)(~_mm256_movemask_ps(_mm256_castsi256_ps(fora)) & 0xFF) << b;
+        }
+        selecao[p] = palavra;
+    }
+    if (completas * BITS_POR_PALAVRA < total) {
+        size_t inicio = completas * BITS_POR_PALAVRA;
+        selecao[completas] = palavra_int_escalar(coluna + inicio, total - inicio, min, max);
+    }
+}
+#endif
+
+static NucleoDouble nucleo_double = NULL;
+static NucleoInt nucleo_int = NULL;
+static NivelSimd nivel_nucleos = NIVEL_ESCALAR;
+
+/* Escolhe os nucleos uma vez, pelo nivel detectado em simd.c */
+static void escolher_nucleos(void) {
+    if (nucleo_double != NULL) {
+        return;
+    }
+    nucleo_double = filtrar_double_escalar;
+    nucleo_int = filtrar_int_escalar;
+#ifdef SIMD_X86
+    nivel_nucleos = nivel_simd();
+    if (nivel_nucleos == NIVEL_AVX2) {
+        nucleo_double = filtrar_double_avx2;
+        nucleo_int = filtrar_int_avx2;
+    } else if (nivel_nucleos == NIVEL_SSE2) {
+        nucleo_double = filtrar_double_sse2;
+        nucleo_int = filtrar_int_sse2;
+    }
+#endif
+}
+
+/* Nome do nivel dos nucleos de filtro (AVX2, SSE2 ou escalar) */
+const char* nivel_simd_filtro(void) {
+    escolher_nucleos();
+    return nome_nivel_simd(nivel_nucleos);
+}
+
+/* Marca em selecao (bit i da palavra i / 64) as linhas com min <= coluna[i] <= max.
+ * Valores NaN nunca sao selecionados. */
+void filtrar_intervalo_double(const double* coluna, size_t total, double min, double max, uint64_t* selecao) {
+    escolher_nucleos();
+    nucleo_double(coluna, total, min, max, selecao);
+}
+
+/* Mesmo filtro para uma coluna de inteiros */
+void filtrar_intervalo_int(const int* coluna, size_t total, int min, int max, uint64_t* selecao) {
+    escolher_nucleos();
+    nucleo_int(coluna, total, min, max, selecao);
+}
+
+/* Conjuncao de predicados: selecao &= outra */
+void intersectar_selecao(uint64_t* selecao, const uint64_t* outra, size_t palavras) {
+    for (size_t p = 0; p < palavras; p++) {
+        selecao[p] &= outra[p];
+    }
+}
+
+/* Quantidade de linhas selecionadas */
+size_t contar_selecao(const uint64_t* selecao, size_t palavras) {
+    size_t total = 0;
+    for (size_t p = 0; p < palavras; p++) {
+#ifdef __GNUC__
+        total += (size_t)__builtin_popcountll(selecao[p]);
+#else
+        for (uint64_t palavra = selecao[p]; palavra != 0; palavra &= palavra - 1) {
+            total++;
+        }
+#endif
+    }
+    return total;
+}
+
+/* Escreve em linhas os indices selecionados, em ordem crescente; retorna quantos */
+size_t linhas_da_selecao(const uint64_t* selecao, size_t total, size_t* linhas) {
+    size_t quantidade = 0;
+    size_t palavras = palavras_selecao(total);
+    for (size_t p = 0; p < palavras; p++) {
+        for (uint64_t palavra = selecao[p]; palavra != 0; palavra &= palavra - 1) {
+#ifdef __GNUC__
+            unsigned bit = (unsigned)__builtin_ctzll(palavra);
+#else
+            unsigned bit = 0;
+            while (((palavra >> bit) & 1) == 0) {
+                bit++;
+            }
+#endif
+            linhas[quantidade++] = p * BITS_POR_PALAVRA + bit;
+        }
+    }
+    return quantidade;
+}
+
+/* Converte os limites reais de um filtro para a coluna de inteiros:
+ * [min, max] vira [teto(min), piso(max)], saturado na faixa de int.
+ * Retorna false se nenhum inteiro couber no intervalo (ou houver NaN). */
+static bool limites_inteiros(double min, double max, int* min_int, int* max_int) {
+    if (!(min <= max) || min > (double)INT_MAX || max < (double)INT_MIN) {
+        return false;
+    }
+    /* A conversao trunca em direcao a zero; o ajuste completa teto e piso */
+    long long inferior = min <= (double)INT_MIN ? INT_MIN : (long long)min;
+    if ((double)inferior < min) {
+        inferior++;
+    }
+    long long superior = max >= (double)INT_MAX ? INT_MAX : (long long)max;
+    if ((double)superior > max) {
+        superior--;
+    }
+    if (inferior > superior) {
+        return false;
+    }
+    *min_int = (int)inferior;
+    *max_int = (int)superior;
+    return true;
+}
+
+/* Avalia a conjuncao dos filtros sobre as colunas da tabela inteira (todas as
+ * categorias), ja sem as linhas removidas. Cada predicado gera sua selecao,
+ * combinada com as anteriores por AND. Retorna a selecao alocada (liberar
+ * com free) ou NULL se faltar memoria. */
+uint64_t* filtrar_tabela(const TabelaAlimentos* tabela, const FiltroIntervalo* filtros, size_t total_filtros) {
+    size_t palavras = palavras_selecao(tabela->total);
+    uint64_t* selecao = (uint64_t*)malloc((palavras > 0 ? palavras : 1) * sizeof(uint64_t));
+    uint64_t* parcial = (uint64_t*)malloc((palavras > 0 ? palavras : 1) * sizeof(uint64_t));
+    if (selecao == NULL || parcial == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para o filtro.\n");
+        free(selecao);
+        free(parcial);
+        return NULL;
+    }
+
+    if (palavras > 0) {
+        memcpy(selecao, tabela->presenca, palavras * sizeof(uint64_t));
+    }
+    for (size_t f = 0; f < total_filtros; f++) {
+        const FiltroIntervalo* filtro = &filtros[f];
+        int min_int;
+        int max_int;
+        switch (filtro->coluna) {
+            case COLUNA_UMIDADE:
+                filtrar_intervalo_double(tabela->umidade, tabela->total, filtro->min, filtro->max, parcial);
+                break;
+            case COLUNA_ENERGIA:
+                if (limites_inteiros(filtro->min, filtro->max, &min_int, &max_int)) {
+                    filtrar_intervalo_int(tabela->energia_kcal, tabela->total, min_int, max_int, parcial);
+                } else {
+                    memset(parcial, 0, palavras * sizeof(uint64_t));
+                }
+                break;
+            case COLUNA_PROTEINA:
+                filtrar_intervalo_double(tabela->proteina, tabela->total, filtro->min, filtro->max, parcial);
+                break;
+            case COLUNA_CARBOIDRATO:
+                filtrar_intervalo_double(tabela->carboidrato, tabela->total, filtro->min, filtro->max, parcial);
+                break;
+        }
+        intersectar_selecao(selecao, parcial, palavras);
+    }
+
+    free(parcial);
+    return selecao;
+}
@@ -0,0 +1,51 @@
+#ifndef FILTRO_H
+#define FILTRO_H
+
+#include "tipos.h"
+#include "tabela.h"
+
+/* Predicado min <= coluna <= max */
+typedef struct {
+    ColunaNutriente coluna;
+    double min;
+    double max;
+} FiltroIntervalo;
+
+/* Nivel dos nucleos de filtro em uso, detectado ao rodar (ver simd.h) */
+const char* nivel_simd_filtro(void);
+
+/* Quantidade de palavras de 64 bits de uma selecao com total linhas */
+size_t palavras_selecao(size_t total_linhas);
+
+/* Marca a linha na selecao */
+static inline void marcar_linha(uint64_t* selecao, size_t linha) {
+    selecao[linha / BITS_POR_PALAVRA] |= (uint64_t)1 << (linha % BITS_POR_PALAVRA);
+}
+
+/* Indica se a linha esta marcada na selecao */
+static inline bool linha_marcada(const uint64_t* selecao, size_t linha) {
+    return (selecao[linha / BITS_POR_PALAVRA] >> (linha % BITS_POR_PALAVRA) & 1) != 0;
+}
+
+/* Marca em selecao (bit i da palavra i / 64) as linhas com min <= coluna[i] <= max.
+ * Valores NaN nunca sao selecionados. */
+void filtrar_intervalo_double(const double* coluna, size_t total, double min, double max, uint64_t* selecao);
+
+/* Mesmo filtro para uma coluna de inteiros */
+void filtrar_intervalo_int(const int* coluna, size_t total, int min, int max, uint64_t* selecao);
+
+/* Conjuncao de predicados: selecao &= outra */
+void intersectar_selecao(uint64_t* selecao, const uint64_t* outra, size_t palavras);
+
+/* Quantidade de linhas selecionadas */
+size_t contar_selecao(const uint64_t* selecao, size_t palavras);
+
+/* Escreve em linhas os indices selecionados, em ordem crescente; retorna quantos */
+size_t linhas_da_selecao(const uint64_t* selecao, size_t total, size_t* linhas);
+
+/* Avalia a conjuncao dos filtros sobre as colunas da tabela inteira (todas as
+ * categorias), ja sem as linhas removidas. Retorna a selecao alocada (liberar
+ * com free) ou NULL se faltar memoria. */
+uint64_t* filtrar_tabela(const TabelaAlimentos* tabela, const FiltroIntervalo* filtros, size_t total_filtros);
+
+#endif
@@ -0,0 +1,371 @@
+#include "formato.h"
+#include "texto.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define CHECKSUM_PRIMO 0x100000001b3ULL
+#define TAMANHO_BUFFER_ESCRITA 65536
+
+/* Posicao (em bytes) de cada secao de um arquivo colunar */
+typedef struct {
+    uint64_t umidade;
+    uint64_t proteina;
+    uint64_t carboidrato;
+    uint64_t numero;
+    uint64_t energia_kcal;
+    uint64_t descricao;
+    uint64_t categoria;
+    uint64_t textos;
+} SecoesColunares;
+
+/* Escrita com buffer que acumula o checksum do que passa por ela */
+typedef struct {
+    FILE* arquivo;
+    unsigned char buffer[TAMANHO_BUFFER_ESCRITA];
+    size_t usado;
+    uint64_t checksum;
+    bool erro;
+} EscritorBinario;
+
+/* Calcula a posicao das secoes a partir das quantidades do cabecalho */
+static SecoesColunares calcular_secoes(uint32_t total_categorias, uint32_t total_registros) {
+    SecoesColunares secoes;
+    uint64_t n = total_registros;
+
+    secoes.umidade = sizeof(CabecalhoArquivo) + (uint64_t)total_categorias * sizeof(EntradaDiretorio);
+    secoes.proteina = secoes.umidade + n * sizeof(double);
+    secoes.carboidrato = secoes.proteina + n * sizeof(double);
+    secoes.descricao = secoes.carboidrato + n * sizeof(double);
+    secoes.numero = secoes.descricao + n * sizeof(RefTexto);
+    secoes.energia_kcal = secoes.numero + n * sizeof(int32_t);
+    secoes.categoria = secoes.energia_kcal + n * sizeof(int32_t);
+    secoes.textos = (secoes.categoria + n * sizeof(uint8_t) + 7) & ~(uint64_t)7;
+    return secoes;
+}
+
+/* Acumula o checksum sobre um bloco de bytes (FNV-1a sobre palavras de 64 bits) */
+uint64_t calcular_checksum(uint64_t checksum, const void* dados, size_t tamanho) {
+    const unsigned char* bytes = (const unsigned char*)dados;
+    size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= tamanho; i += sizeof(uint64_t)) {
+        uint64_t palavra;
+        memcpy(&palavra, bytes + i, sizeof(uint64_t));
+        checksum = (checksum ^ palavra) * CHECKSUM_PRIMO;
+        checksum ^= checksum >> 32;
+    }
+
+    for (; i < tamanho; i++) {
+        checksum = (checksum ^ bytes[i]) * CHECKSUM_PRIMO;
+    }
+
+    return checksum;
+}
+
+/* Verifica cabecalho, tamanho e checksum de um arquivo mapeado */
+uint32_t validar_arquivo_binario(const unsigned char* dados, size_t tamanho) {
+    if (tamanho < sizeof(CabecalhoArquivo) ||
+        memcmp(dados, FORMATO_MAGICA, sizeof(((CabecalhoArquivo*)0)->magica)) != 0) {
+        /* Sem cabecalho: formato legado, uma sequencia de registros */
+        if (tamanho == 0 || tamanho % sizeof(AlimentoArquivo) != 0) {
+            fprintf(stderr, "Arquivo binario truncado ou corrompido.\n");
+            return 0;
+        }
+        return FORMATO_VERSAO_LEGADA;
+    }
+
+    const CabecalhoArquivo* cabecalho = (const CabecalhoArquivo*)dados;
+
+    if (cabecalho->versao != FORMATO_VERSAO) {
+        fprintf(stderr, "Versao %u do arquivo binario nao suportada (esperada %u).\n",
+                cabecalho->versao, FORMATO_VERSAO);
+        return 0;
+    }
+
+    /* O pool de textos pode estar vazio */
+    uint64_t esperado = calcular_secoes(cabecalho->total_categorias, cabecalho->total_registros).textos;
+    if (cabecalho->tamanho_arquivo != tamanho || esperado > tamanho) {
+        fprintf(stderr, "Arquivo binario truncado ou corrompido.\n");
+        return 0;
+    }
+
+    uint64_t checksum = calcular_checksum(CHECKSUM_INICIAL, dados + sizeof(CabecalhoArquivo),
+                                          tamanho - sizeof(CabecalhoArquivo));
+    if (checksum != cabecalho->checksum) {
+        fprintf(stderr, "Checksum do arquivo binario nao confere.\n");
+        return 0;
+    }
+
+    const EntradaDiretorio* diretorio = (const EntradaDiretorio*)(dados + sizeof(CabecalhoArquivo));
+    for (uint32_t i = 0; i < cabecalho->total_categorias; i++) {
+        const EntradaDiretorio* entrada = &diretorio[i];
+        bool valida = entrada->nome[MAX_CATEGORIA - 1] == '\0';
+
+        /* Sem somar offset e quantidade: um offset perto de UINT64_MAX daria a volta */
+        valida = valida && entrada->offset <= cabecalho->total_registros &&
+                 entrada->quantidade <= cabecalho->total_registros - entrada->offset;
+
+        if (!valida) {
+            fprintf(stderr, "Diretorio de categorias invalido no arquivo binario.\n");
+            return 0;
+        }
+    }
+
+    return FORMATO_VERSAO;
+}
+
+/* Localiza as colunas de um arquivo colunar ja validado */
+void obter_colunas_arquivo(const unsigned char* dados, size_t tamanho, ColunasArquivo* colunas) {
+    const CabecalhoArquivo* cabecalho = (const CabecalhoArquivo*)dados;
+    SecoesColunares secoes = calcular_secoes(cabecalho->total_categorias, cabecalho->total_registros);
+
+    colunas->total = cabecalho->total_registros;
+    colunas->umidade = (const double*)(dados + secoes.umidade);
+    colunas->proteina = (const double*)(dados + secoes.proteina);
+    colunas->carboidrato = (const double*)(dados + secoes.carboidrato);
+    colunas->numero = (const int32_t*)(dados + secoes.numero);
+    colunas->energia_kcal = (const int32_t*)(dados + secoes.energia_kcal);
+    colunas->descricao = (const RefTexto*)(dados + secoes.descricao);
+    colunas->categoria = (const uint8_t*)(dados + secoes.categoria);
+    colunas->textos = (const char*)(dados + secoes.textos);
+    colunas->tamanho_textos = tamanho - secoes.textos;
+}
+
+/* Substitui o arquivo de destino pelo arquivo temporario recem-gravado.
+ * O destino pode estar mapeado em memoria, por isso nunca e truncado. */
+static bool substituir_arquivo(const char* temporario, const char* destino) {
+#ifdef _WIN32
+    char antigo[FILENAME_MAX];
+    snprintf(antigo, sizeof(antigo), "%s.old", destino);
+    remove(antigo);
+    MoveFileA(destino, antigo);
+    if (!MoveFileA(temporario, destino)) {
+        MoveFileA(antigo, destino);
+        return false;
+    }
+    remove(antigo);
+    return true;
+#else
+    return rename(temporario, destino) == 0;
+#endif
+}
+
+/* Descarrega o buffer no arquivo, acumulando o checksum */
+static void descarregar(EscritorBinario* escritor) {
+    if (escritor->usado == 0) {
+        return;
+    }
+    escritor->checksum = calcular_checksum(escritor->checksum, escritor->buffer, escritor->usado);
+    if (fwrite(escritor->buffer, escritor->usado, 1, escritor->arquivo) != 1) {
+        escritor->erro = true;
+    }
+    escritor->usado = 0;
+}
+
+/* Escreve bytes pelo buffer (descargas intermediarias tem tamanho multiplo de 8) */
+static void escrever(EscritorBinario* escritor, const void* dados, size_t tamanho) {
+    const unsigned char* bytes = (const unsigned char*)dados;
+    while (tamanho > 0) {
+        size_t livre = TAMANHO_BUFFER_ESCRITA - escritor->usado;
+        size_t parte = tamanho < livre ? tamanho : livre;
+        memcpy(escritor->buffer + escritor->usado, bytes, parte);
+        escritor->usado += parte;
+        bytes += parte;
+        tamanho -= parte;
+        if (escritor->usado == TAMANHO_BUFFER_ESCRITA) {
+            descarregar(escritor);
+        }
+    }
+}
+
+/* Grava os registros no formato atual, agrupados por categoria */
+bool gravar_arquivo_binario(const char* caminho, const RegistroAlimento* registros, size_t total) {
+    /* O cabecalho, o diretorio e as secoes contam as linhas em 32 bits */
+    if ((uint64_t)total > FORMATO_MAX_REGISTROS) {
+        fprintf(stderr, "Registros demais para o arquivo binario (maximo %lu).\n",
+                (unsigned long)FORMATO_MAX_REGISTROS);
+        return false;
+    }
+
+    /* Descobre as categorias distintas, na ordem em que aparecem */
+    size_t capacidade = total > 0 ? total : 1;
+    const char** nomes = (const char**)malloc(capacidade * sizeof(const char*));
+    uint32_t* quantidades = (uint32_t*)calloc(capacidade, sizeof(uint32_t));
+    uint32_t* indice_categoria = (uint32_t*)malloc(capacidade * sizeof(uint32_t));
+    size_t* ordem = (size_t*)malloc(capacidade * sizeof(size_t));
+    RefTexto* referencias = (RefTexto*)malloc(capacidade * sizeof(RefTexto));
+    EscritorBinario* escritor = (EscritorBinario*)malloc(sizeof(EscritorBinario));
+    if (nomes == NULL || quantidades == NULL || indice_categoria == NULL ||
+        ordem == NULL || referencias == NULL || escritor == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para gravar o arquivo binario.\n");
+        free(nomes);
+        free(quantidades);
+        free(indice_categoria);
+        free(ordem);
+        free(referencias);
+        free(escritor);
+        return false;
+    }
+
+    uint32_t total_categorias = 0;
+    uint32_t ultima = 0;
+    for (size_t i = 0; i < total; i++) {
+        /* Registros da mesma categoria costumam vir em sequencia */
+        if (total_categorias > 0 && strcmp(nomes[ultima], registros[i].categoria) == 0) {
+            indice_categoria[i] = ultima;
+            quantidades[ultima]++;
+            continue;
+        }
+
+        uint32_t c = 0;
+        while (c < total_categorias && strcmp(nomes[c], registros[i].categoria) != 0) {
+            c++;
+        }
+        if (c == total_categorias) {
+            nomes[total_categorias++] = registros[i].categoria;
+        }
+        indice_categoria[i] = c;
+        quantidades[c]++;
+        ultima = c;
+    }
+
+    if (total_categorias > FORMATO_MAX_CATEGORIAS) {
+        fprintf(stderr, "Categorias demais para o arquivo binario (maximo %d).\n", FORMATO_MAX_CATEGORIAS);
+        free(nomes);
+        free(quantidades);
+        free(indice_categoria);
+        free(ordem);
+        free(referencias);
+        free(escritor);
+        return false;
+    }
+
+    /* Ordena os registros por categoria com uma contagem (estavel, O(n)).
+     * quantidades[] vira a primeira linha de cada categoria. */
+    uint32_t linha = 0;
+    for (uint32_t c = 0; c < total_categorias; c++) {
+        uint32_t quantidade = quantidades[c];
+        quantidades[c] = linha;
+        linha += quantidade;
+    }
+    for (size_t i = 0; i < total; i++) {
+        ordem[quantidades[indice_categoria[i]]++] = i;
+    }
+
+    /* Interna as descricoes na ordem das linhas; textos repetidos sao gravados uma vez */
+    PoolTextos pool;
+    inicializar_pool_textos(&pool);
+    for (size_t k = 0; k < total; k++) {
+        const RegistroAlimento* registro = &registros[ordem[k]];
+        referencias[k] = internar_texto(&pool, registro->descricao, registro->tamanho_descricao);
+    }
+
+    char temporario[FILENAME_MAX];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+
+    escritor->arquivo = fopen(temporario, "wb");
+    if (escritor->arquivo == NULL) {
+        perror("Erro ao criar arquivo binario");
+        free(nomes);
+        free(quantidades);
+        free(indice_categoria);
+        free(ordem);
+        free(referencias);
+        liberar_pool_textos(&pool);
+        free(escritor);
+        return false;
+    }
+    escritor->usado = 0;
+    escritor->checksum = CHECKSUM_INICIAL;
+    escritor->erro = false;
+
+    /* Reserva o espaco do cabecalho; ele e reescrito no final com o checksum */
+    CabecalhoArquivo cabecalho;
+    memset(&cabecalho, 0, sizeof(CabecalhoArquivo));
+    memcpy(cabecalho.magica, FORMATO_MAGICA, sizeof(cabecalho.magica));
+    cabecalho.versao = FORMATO_VERSAO;
+    cabecalho.total_registros = (uint32_t)total;
+    cabecalho.total_categorias = total_categorias;
+    bool sucesso = fwrite(&cabecalho, sizeof(CabecalhoArquivo), 1, escritor->arquivo) == 1;
+
+    /* Diretorio: apos a contagem, quantidades[c] e o fim da categoria c */
+    uint32_t primeira = 0;
+    for (uint32_t c = 0; c < total_categorias; c++) {
+        EntradaDiretorio entrada;
+        memset(&entrada, 0, sizeof(EntradaDiretorio));
+        strncpy(entrada.nome, nomes[c], MAX_CATEGORIA - 1);
+        entrada.quantidade = quantidades[c] - primeira;
+        entrada.offset = primeira;
+        primeira = quantidades[c];
+        escrever(escritor, &entrada, sizeof(EntradaDiretorio));
+    }
+
+    /* Colunas, uma de cada vez, na ordem das linhas */
+    for (size_t k = 0; k < total; k++) {
+        escrever(escritor, &registros[ordem[k]].umidade, sizeof(double));
+    }
+    for (size_t k = 0; k < total; k++) {
+        escrever(escritor, &registros[ordem[k]].proteina, sizeof(double));
+    }
+    for (size_t k = 0; k < total; k++) {
+        escrever(escritor, &registros[ordem[k]].carboidrato, sizeof(double));
+    }
+    for (size_t k = 0; k < total; k++) {
+        escrever(escritor, &referencias[k], sizeof(RefTexto));
+    }
+    for (size_t k = 0; k < total; k++) {
+        int32_t numero = registros[ordem[k]].numero;
+        escrever(escritor, &numero, sizeof(int32_t));
+    }
+    for (size_t k = 0; k < total; k++) {
+        int32_t energia = registros[ordem[k]].energia_kcal;
+        escrever(escritor, &energia, sizeof(int32_t));
+    }
+
+    for (size_t k = 0; k < total; k++) {
+        uint8_t codigo = (uint8_t)indice_categoria[ordem[k]];
+        escrever(escritor, &codigo, sizeof(uint8_t));
+    }
+
+    SecoesColunares secoes = calcular_secoes(total_categorias, (uint32_t)total);
+    uint64_t fim_colunas = secoes.categoria + (uint64_t)total * sizeof(uint8_t);
+    const unsigned char zeros[8] = {0};
+    escrever(escritor, zeros, (size_t)(secoes.textos - fim_colunas));
+
+    escrever(escritor, pool.dados, pool.tamanho);
+    descarregar(escritor);
+    sucesso = sucesso && !escritor->erro;
+
+    uint64_t tamanho_pool = pool.tamanho;
+    free(nomes);
+    free(quantidades);
+    free(indice_categoria);
+    free(ordem);
+    free(referencias);
+    liberar_pool_textos(&pool);
+
+    if (sucesso) {
+        cabecalho.tamanho_arquivo = secoes.textos + tamanho_pool;
+        cabecalho.checksum = escritor->checksum;
+        sucesso = fseek(escritor->arquivo, 0, SEEK_SET) == 0 &&
+                  fwrite(&cabecalho, sizeof(CabecalhoArquivo), 1, escritor->arquivo) == 1;
+    }
+
+    if (fclose(escritor->arquivo) != 0) {
+        sucesso = false;
+    }
+    free(escritor);
+
+    if (!sucesso || !substituir_arquivo(temporario, caminho)) {
+        perror("Erro ao gravar arquivo binario");
+        remove(temporario);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,95 @@
+#ifndef FORMATO_H
+#define FORMATO_H
+
+#include "tipos.h"
+#include <stdint.h>
+
+/* Formato do arquivo binario (versao 5, colunar):
+ *   CabecalhoArquivo
+ *   EntradaDiretorio[total_categorias]
+ *   double  umidade[n], proteina[n], carboidrato[n]
+ *   RefTexto descricao[n]   (posicao e tamanho do texto no pool)
+ *   int32_t numero[n], energia_kcal[n]
+ *   uint8_t categoria[n]    (codigo: indice da categoria no diretorio)
+ *   preenchimento ate multiplo de 8
+ *   pool de textos internados (ver texto.h), ate o fim do arquivo
+ * O diretorio e o dicionario dos codigos de categoria. As linhas sao
+ * agrupadas por categoria; o diretorio guarda a primeira linha e a
+ * quantidade de cada uma. O checksum cobre tudo o que vem depois do
+ * cabecalho.
+ *
+ * O formato legado (versao 1, uma sequencia de AlimentoArquivo sem
+ * cabecalho) continua legivel. */
+#define FORMATO_MAGICA "TACO"
+#define FORMATO_VERSAO 5
+#define FORMATO_VERSAO_LEGADA 1
+
+#define CHECKSUM_INICIAL 0xcbf29ce484222325ULL
+
+/* Maior quantidade de categorias representavel na coluna de codigos */
+#define FORMATO_MAX_CATEGORIAS 256
+
+/* Maior quantidade de registros representavel no cabecalho */
+#define FORMATO_MAX_REGISTROS UINT32_MAX
+
+/* Cabecalho do arquivo binario (32 bytes) */
+typedef struct {
+    char magica[4];
+    uint32_t versao;
+    uint32_t total_registros;
+    uint32_t total_categorias;
+    uint64_t tamanho_arquivo;
+    uint64_t checksum;
+} CabecalhoArquivo;
+
+/* Entrada do diretorio de categorias (64 bytes) */
+typedef struct {
+    char nome[MAX_CATEGORIA];
+    char preenchimento[2];
+    uint32_t quantidade;   /* numero de registros da categoria */
+    uint64_t offset;       /* primeira linha da categoria */
+} EntradaDiretorio;
+
+/* Colunas de um arquivo colunar, apontando direto para o mapeamento */
+typedef struct {
+    uint32_t total;
+    const double* umidade;
+    const double* proteina;
+    const double* carboidrato;
+    const int32_t* numero;
+    const int32_t* energia_kcal;
+    const RefTexto* descricao;
+    const uint8_t* categoria;
+    const char* textos;
+    uint64_t tamanho_textos;
+} ColunasArquivo;
+
+/* Alimento a ser gravado (as strings pertencem a quem chama) */
+typedef struct {
+    int numero;
+    const char* descricao;
+    uint32_t tamanho_descricao;
+    double umidade;
+    int energia_kcal;
+    double proteina;
+    double carboidrato;
+    const char* categoria;
+} RegistroAlimento;
+
+/* Acumula o checksum sobre um bloco de bytes.
+ * Blocos intermediarios devem ter tamanho multiplo de 8. */
+uint64_t calcular_checksum(uint64_t checksum, const void* dados, size_t tamanho);
+
+/* Verifica cabecalho, tamanho e checksum de um arquivo mapeado.
+ * Retorna a versao do arquivo ou 0 se ele for invalido. */
+uint32_t validar_arquivo_binario(const unsigned char* dados, size_t tamanho);
+
+/* Localiza as colunas de um arquivo colunar ja validado */
+void obter_colunas_arquivo(const unsigned char* dados, size_t tamanho, ColunasArquivo* colunas);
+
+/* Grava os registros no formato atual, agrupados por categoria.
+ * O arquivo e escrito em um temporario e depois renomeado sobre o destino.
+ * Falha, sem gravar nada, com mais de FORMATO_MAX_REGISTROS registros. */
+bool gravar_arquivo_binario(const char* caminho, const RegistroAlimento* registros, size_t total);
+
+#endif
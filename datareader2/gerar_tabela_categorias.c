@@ -0,0 +1,82 @@
+/* Gera tabela_categorias.h: procura uma semente para hash_nome_categoria
+ * que leve cada nome de categorias.def (canonicos e sinonimos) a uma
+ * posicao diferente da menor tabela possivel, e grava essa tabela.
+ * Uso: ./gerar_tabela_categorias > tabela_categorias.h */
+#include "categorias_hash.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BITS_MAXIMO 10
+#define TENTATIVAS_POR_TAMANHO 1000000
+
+static const char* const NOMES[] = {
+#define CATEGORIA(tipo, nome) nome,
+#define SINONIMO(tipo, nome) nome,
+#include "categorias.def"
+#undef CATEGORIA
+#undef SINONIMO
+};
+
+#define TOTAL_NOMES (sizeof(NOMES) / sizeof(NOMES[0]))
+
+/* Gerador pseudo-aleatorio simples (xorshift), para a saida ser reprodutivel */
+static uint32_t estado = 2463534242u;
+static uint32_t proximo_aleatorio(void) {
+    estado ^= estado << 13;
+    estado ^= estado >> 17;
+    estado ^= estado << 5;
+    return estado;
+}
+
+/* Preenche 'tabela' com a posicao de cada nome; retorna 0 em colisao */
+static int testar_semente(uint32_t semente, unsigned bits, int* tabela) {
+    size_t posicoes = (size_t)1 << bits;
+    for (size_t p = 0; p < posicoes; p++) {
+        tabela[p] = -1;
+    }
+    for (size_t i = 0; i < TOTAL_NOMES; i++) {
+        uint32_t h = hash_nome_categoria(NOMES[i], strlen(NOMES[i]), semente, bits);
+        if (tabela[h] >= 0) {
+            return 0;
+        }
+        tabela[h] = (int)i;
+    }
+    return 1;
+}
+
+int main(void) {
+    int tabela[1 << BITS_MAXIMO];
+    unsigned bits = 1;
+    while (((size_t)1 << bits) < TOTAL_NOMES) {
+        bits++;
+    }
+
+    for (; bits <= BITS_MAXIMO; bits++) {
+        for (long tentativa = 0; tentativa < TENTATIVAS_POR_TAMANHO; tentativa++) {
+            uint32_t semente = proximo_aleatorio() | 1u;
+            if (!testar_semente(semente, bits, tabela)) {
+                continue;
+            }
+
+            size_t posicoes = (size_t)1 << bits;
+            printf("/* Gerado por gerar_tabela_categorias a partir de categorias.def.\n");
+            printf(" * Nao editar: use 'make tabela_categorias.h'. */\n");
+            printf("#ifndef TABELA_CATEGORIAS_H\n#define TABELA_CATEGORIAS_H\n\n");
+            printf("#include <stdint.h>\n\n");
+            printf("#define HASH_CATEGORIAS_SEMENTE 0x%08lxu\n", (unsigned long)semente);
+            printf("#define HASH_CATEGORIAS_BITS %u\n", bits);
+            printf("#define HASH_CATEGORIAS_TOTAL_NOMES %lu\n\n", (unsigned long)TOTAL_NOMES);
+            printf("/* Posicao do hash -> indice do nome em categorias.def (-1: vazia) */\n");
+            printf("static const int8_t TABELA_HASH_CATEGORIAS[%lu] = {", (unsigned long)posicoes);
+            for (size_t p = 0; p < posicoes; p++) {
+                const char* separador = p == 0 ? "\n    " : (p % 16 == 0 ? ",\n    " : ", ");
+                printf("%s%d", separador, tabela[p]);
+            }
+            printf("\n};\n\n#endif\n");
+            return 0;
+        }
+    }
+
+    fprintf(stderr, "Nenhuma semente sem colisoes encontrada; revise hash_nome_categoria.\n");
+    return 1;
+}
@@ -27,6 +27,10 @@
 #include "gui.h"           // Definicoes de IDs, estruturas, prototipos
 #include "categoria.h"     // Funcoes de manipulacao de categorias
 #include "arvore.h"        // Funcoes de arvore binaria
+#include "registro.h"      // Busca de categorias por nome (tabela hash)
+#include "indice_numero.h" // Busca de alimentos por numero (tabela hash)
+#include "indices.h"       // Indices secundarios (arvores por nutriente)
+#include "tabela.h"        // Tabela colunar de alimentos (particoes por categoria)
 #include "dialogo.h"       // Sistema de dialogos personalizados
 #include <stdio.h>         // sprintf, printf
 #include <stdlib.h>        // malloc, free
@@ -446,7 +450,7 @@ void CriarControles(HWND hwnd) {
  * 7. Atualiza barra de status
  *
  * ESTRUTURA DE DADOS:
- * app->lista_categorias e uma lista encadeada ordenada alfabeticamente
+ * app->base->lista_categorias e uma lista encadeada ordenada alfabeticamente
  * Cada NoCategoria tem:
  * - nome: string com nome da categoria
  * - proximo: ponteiro para proxima categoria (NULL no fim)
@@ -456,7 +460,7 @@ void OnListarCategorias(AppData* app) {
     LimparListBox(app->hwndListBox);
 
     /* Verificar se lista esta vazia */
-    if (app->lista_categorias == NULL) {
+    if (app->base->lista_categorias == NULL) {
         AdicionarItemListBox(app->hwndListBox, "Nenhuma categoria encontrada.");
         return;  // Sair da funcao se nao ha dados
     }
@@ -470,7 +474,7 @@ void OnListarCategorias(AppData* app) {
 
     /* Variaveis para percorrer lista */
     int contador = 1;                         // Contador para numerar categorias (inicia em 1)
-    NoCategoria* atual = app->lista_categorias;  // Ponteiro para navegar pela lista
+    NoCategoria* atual = app->base->lista_categorias;  // Ponteiro para navegar pela lista
     char buffer[512];                         // Buffer temporario para formatar strings
 
     /* Loop para percorrer toda a lista encadeada */
@@ -522,27 +526,24 @@ void OnListarCategorias(AppData* app) {
  * 4. Exibe em formato de tabela bonita
  *
  * ESTRUTURA DE DADOS:
- * NoCategoria contem:
- * - lista_alimentos: lista encadeada de NoAlimento
- * Cada NoAlimento contem:
- * - numero: numero de identificacao
- * - descricao: nome do alimento
- * - energia_kcal: energia em kcal
- * - proteina: proteina em gramas
- * - proximo: proximo alimento na lista
+ * Os alimentos ficam na tabela colunar (app->base->tabela):
+ * - cada categoria e uma particao: faixa de linhas [inicio, fim)
+ * - numero, energia_kcal, proteina: um vetor por coluna
+ * - alimento[linha]: NoAlimento da linha (descricao)
+ * - linhas removidas sao puladas por proxima_linha
  */
 void OnListarAlimentos(AppData* app) {
     char categoria[MAX_CATEGORIA];  // Buffer para armazenar nome da categoria selecionada
 
     /* Mostrar dialogo de selecao de categoria */
     /* Retorna FALSE se usuario cancelou */
-    if (!MostrarDialogoCategoria(app->hwndMain, app->lista_categorias, categoria)) {
+    if (!MostrarDialogoCategoria(app->hwndMain, app->base->lista_categorias, categoria)) {
         return;  // Usuario cancelou, sair da funcao
     }
 
     /* Buscar categoria na lista usando nome */
-    /* buscar_categoria retorna ponteiro para NoCategoria ou NULL se nao encontrou */
-    NoCategoria* cat = buscar_categoria(app->lista_categorias, categoria);
+    /* buscar_categoria_registro (tabela hash) retorna ponteiro para NoCategoria ou NULL se nao encontrou */
+    NoCategoria* cat = buscar_categoria_registro(&app->base->categorias, categoria);
 
     /* Limpar listbox para novo conteudo */
     LimparListBox(app->hwndListBox);
@@ -571,26 +572,25 @@ void OnListarAlimentos(AppData* app) {
     /* Adicionar cabecalho da tabela de alimentos */
     AdicionarCabecalhoTabela(app->hwndListBox);
 
-    /* Percorrer lista de alimentos da categoria */
+    /* Percorrer as linhas da particao da categoria na tabela */
+    const TabelaAlimentos* tabela = &app->base->tabela;
+    const ParticaoTabela* particao = particao_categoria(tabela, cat);
     int total = 0;                          // Contador de alimentos
-    NoAlimento* alim = cat->lista_alimentos;  // Ponteiro para navegar lista de alimentos
 
-    while (alim != NULL) {
+    for (size_t linha = proxima_linha(tabela, particao->inicio, particao->fim); linha < particao->fim;
+         linha = proxima_linha(tabela, linha + 1, particao->fim)) {
         /* Formatar linha da tabela com dados do alimento */
         /* %3d = numero com 3 digitos, alinhado a direita */
         /* %-50s = descricao com 50 caracteres, alinhada a esquerda */
         /* %4d = energia com 4 digitos */
         /* %6.1f = proteina com 6 caracteres total, 1 casa decimal */
         sprintf(buffer, " %3d | %-50s | %4d kcal | %6.1f g",
-                alim->numero,
-                alim->descricao,
-                alim->energia_kcal,
-                alim->proteina);
+                tabela->numero[linha],
+                tabela->alimento[linha]->descricao,
+                tabela->energia_kcal[linha],
+                tabela->proteina[linha]);
 
         AdicionarItemListBox(app->hwndListBox, buffer);
-
-        /* Avancar para proximo alimento */
-        alim = alim->proximo;
         total++;  // Incrementar contador
     }
 
@@ -605,11 +605,11 @@ void OnListarAlimentos(AppData* app) {
 }
 
 /******************************************************************************
- * FUNCOES AUXILIARES RECURSIVAS PARA ARVORES BINARIAS
+ * FUNCOES AUXILIARES PARA ARVORES BINARIAS
  *
- * Estas funcoes percorrem arvores binarias de busca de forma recursiva.
- * Sao usadas para ordenar alimentos por energia/proteina e para buscar
- * intervalos.
+ * Estas funcoes percorrem arvores binarias de busca com um cursor (ver
+ * arvore.h), em lacos simples sem recursao. Sao usadas para ordenar
+ * alimentos por energia/proteina e para buscar intervalos.
  *****************************************************************************/
 
 /**
@@ -618,10 +618,12 @@ void OnListarAlimentos(AppData* app) {
  * @param raiz: Ponteiro para no raiz da arvore (ou subarvore)
  * @param hwndListBox: Handle da listbox onde adicionar resultados
  *
- * FUNCIONAMENTO (Percurso In-Order Reverso):
- * 1. Visitar subarvore DIREITA (valores maiores) - recursao
+ * FUNCIONAMENTO (Cursor, sem recursao):
+ * 1. cursor_fim posiciona no maior no (o mais a direita)
  * 2. Processar no atual (adicionar a listbox)
- * 3. Visitar subarvore ESQUERDA (valores menores) - recursao
+ * 3. cursor_anterior volta para o no imediatamente menor
+ * O cursor guarda o caminho numa pilha propria (ver arvore.h), entao
+ * arvores profundas nao consomem a pilha de chamadas.
  *
  * ESTRUTURA DA ARVORE:
  * NoArvore contem:
@@ -638,32 +640,24 @@ void OnListarAlimentos(AppData* app) {
  *   20  40 60  80
  *
  * Ordem decrescente: 80, 70, 60, 50, 40, 30, 20
- * Percurso: direita -> raiz -> esquerda
  */
 void AdicionarNosArvoreDecrescente(NoArvore* raiz, HWND hwndListBox) {
-    /* Caso base: se raiz e NULL, arvore vazia, retornar */
-    if (raiz == NULL) return;
+    CursorArvore cursor;
 
-    /* PASSO 1: Visitar subarvore direita (valores maiores que raiz) */
-    /* Chamada recursiva: processa toda subarvore direita antes de continuar */
-    AdicionarNosArvoreDecrescente(raiz->direita, hwndListBox);
-
-    /* PASSO 2: Processar no atual (raiz desta subarvore) */
-    char buffer[512];
-
-    /* Formatar dados do alimento associado a este no */
-    sprintf(buffer, " %3d | %-50s | %4d kcal | %6.1f g",
-            raiz->alimento->numero,
-            raiz->alimento->descricao,
-            raiz->alimento->energia_kcal,
-            raiz->alimento->proteina);
+    for (cursor_fim(&cursor, raiz); cursor_atual(&cursor) != NULL; cursor_anterior(&cursor)) {
+        NoArvore* no = cursor_atual(&cursor);
+        char buffer[512];
 
-    /* Adicionar a listbox */
-    AdicionarItemListBox(hwndListBox, buffer);
+        /* Formatar dados do alimento associado a este no */
+        sprintf(buffer, " %3d | %-50s | %4d kcal | %6.1f g",
+                no->alimento->numero,
+                no->alimento->descricao,
+                no->alimento->energia_kcal,
+                no->alimento->proteina);
 
-    /* PASSO 3: Visitar subarvore esquerda (valores menores que raiz) */
-    /* Chamada recursiva: processa toda subarvore esquerda */
-    AdicionarNosArvoreDecrescente(raiz->esquerda, hwndListBox);
+        /* Adicionar a listbox */
+        AdicionarItemListBox(hwndListBox, buffer);
+    }
 }
 
 /**
@@ -674,14 +668,13 @@ void AdicionarNosArvoreDecrescente(NoArvore* raiz, HWND hwndListBox) {
  * @param min: Valor minimo do intervalo (inclusivo)
  * @param max: Valor maximo do intervalo (inclusivo)
  *
- * FUNCIONAMENTO (Busca Otimizada):
- * - Usa propriedade da BST para podar ramos desnecessarios
- * - Se chave > min: pode haver valores validos a esquerda
- * - Se min <= chave <= max: no atual esta no intervalo
- * - Se chave < max: pode haver valores validos a direita
+ * FUNCIONAMENTO (Cursor, sem recursao):
+ * - cursor_buscar desce uma vez ate o primeiro no com chave >= min
+ * - cursor_proximo avanca em ordem crescente enquanto chave <= max
  *
  * OTIMIZACAO:
- * Nao precisa visitar todos os nos, apenas os que podem estar no intervalo.
+ * Nao precisa visitar todos os nos, apenas o caminho ate min e os que
+ * estao no intervalo.
  *
  * EXEMPLO: Buscar intervalo [30, 60] na arvore:
  *         50
@@ -691,36 +684,23 @@ void AdicionarNosArvoreDecrescente(NoArvore* raiz, HWND hwndListBox) {
  *   20  40 60  80
  *
  * Resultado: 30, 40, 50, 60
- * Nao visita: 20 (< min), 70 e 80 (> max)
  */
 void AdicionarNosIntervalo(NoArvore* raiz, HWND hwndListBox, double min, double max) {
-    /* Caso base: arvore vazia */
-    if (raiz == NULL) return;
-
-    /* OTIMIZACAO: Se chave > min, pode haver valores validos a esquerda */
-    /* Exemplo: raiz=50, min=30 → pode ter 30, 40 a esquerda */
-    if (raiz->chave > min) {
-        AdicionarNosIntervalo(raiz->esquerda, hwndListBox, min, max);
-    }
+    CursorArvore cursor;
 
-    /* Verificar se no atual esta dentro do intervalo */
-    if (raiz->chave >= min && raiz->chave <= max) {
-        /* No esta no intervalo, adicionar a lista */
+    for (cursor_buscar(&cursor, raiz, min);
+         cursor_atual(&cursor) != NULL && cursor_atual(&cursor)->chave <= max;
+         cursor_proximo(&cursor)) {
+        NoArvore* no = cursor_atual(&cursor);
         char buffer[512];
         sprintf(buffer, " %3d | %-50s | %4d kcal | %6.1f g",
-                raiz->alimento->numero,
-                raiz->alimento->descricao,
-                raiz->alimento->energia_kcal,
-                raiz->alimento->proteina);
+                no->alimento->numero,
+                no->alimento->descricao,
+                no->alimento->energia_kcal,
+                no->alimento->proteina);
 
         AdicionarItemListBox(hwndListBox, buffer);
     }
-
-    /* OTIMIZACAO: Se chave < max, pode haver valores validos a direita */
-    /* Exemplo: raiz=50, max=60 → pode ter 60 a direita */
-    if (raiz->chave < max) {
-        AdicionarNosIntervalo(raiz->direita, hwndListBox, min, max);
-    }
 }
 
 /******************************************************************************
@@ -743,7 +723,7 @@ void AdicionarNosIntervalo(NoArvore* raiz, HWND hwndListBox, double min, double
  *
  * ESTRUTURA DE DADOS:
  * NoCategoria contem:
- * - arvore_energia: arvore binaria indexada por energia (kcal)
+ * - indices[INDICE_ENERGIA]: arvore binaria indexada por energia (kcal)
  * Cada no da arvore aponta para um alimento
  * Arvore esta ordenada: esquerda < raiz < direita
  * Percurso in-order reverso resulta em ordem decrescente
@@ -752,12 +732,12 @@ void OnListarPorEnergia(AppData* app) {
     char categoria[MAX_CATEGORIA];
 
     /* Dialogo de selecao de categoria */
-    if (!MostrarDialogoCategoria(app->hwndMain, app->lista_categorias, categoria)) {
+    if (!MostrarDialogoCategoria(app->hwndMain, app->base->lista_categorias, categoria)) {
         return;  // Cancelado
     }
 
     /* Buscar categoria */
-    NoCategoria* cat = buscar_categoria(app->lista_categorias, categoria);
+    NoCategoria* cat = buscar_categoria_registro(&app->base->categorias, categoria);
 
     if (cat == NULL) {
         MostrarMensagem(app->hwndMain, "Erro", "Categoria nao encontrada!");
@@ -782,10 +762,10 @@ void OnListarPorEnergia(AppData* app) {
     AdicionarCabecalhoTabela(app->hwndListBox);
 
     /* Percorrer arvore em ordem decrescente */
-    /* A arvore arvore_energia foi construida ao carregar dados */
+    /* O indice de energia foi construido ao carregar dados (ver indices.h) */
     /* Cada no tem chave = energia_kcal */
-    if (cat->arvore_energia != NULL) {
-        AdicionarNosArvoreDecrescente(cat->arvore_energia, app->hwndListBox);
+    if (cat->indices[INDICE_ENERGIA] != NULL) {
+        AdicionarNosArvoreDecrescente(cat->indices[INDICE_ENERGIA], app->hwndListBox);
     }
 
     /* Rodape */
@@ -807,21 +787,21 @@ void OnListarPorEnergia(AppData* app) {
  * @param app: Ponteiro para dados da aplicacao
  *
  * FUNCIONAMENTO:
- * Identico a OnListarPorEnergia, mas usa arvore_proteina ao inves de arvore_energia.
+ * Identico a OnListarPorEnergia, mas usa o indice de proteina ao inves do de energia.
  *
  * ESTRUTURA DE DADOS:
- * NoCategoria->arvore_proteina: BST indexada por proteina (g)
+ * NoCategoria->indices[INDICE_PROTEINA]: BST indexada por proteina (g)
  */
 void OnListarPorProteina(AppData* app) {
     char categoria[MAX_CATEGORIA];
 
     /* Dialogo de selecao */
-    if (!MostrarDialogoCategoria(app->hwndMain, app->lista_categorias, categoria)) {
+    if (!MostrarDialogoCategoria(app->hwndMain, app->base->lista_categorias, categoria)) {
         return;
     }
 
     /* Buscar categoria */
-    NoCategoria* cat = buscar_categoria(app->lista_categorias, categoria);
+    NoCategoria* cat = buscar_categoria_registro(&app->base->categorias, categoria);
 
     if (cat == NULL) {
         MostrarMensagem(app->hwndMain, "Erro", "Categoria nao encontrada!");
@@ -846,8 +826,8 @@ void OnListarPorProteina(AppData* app) {
     AdicionarCabecalhoTabela(app->hwndListBox);
 
     /* Percorrer arvore de proteina em ordem decrescente */
-    if (cat->arvore_proteina != NULL) {
-        AdicionarNosArvoreDecrescente(cat->arvore_proteina, app->hwndListBox);
+    if (cat->indices[INDICE_PROTEINA] != NULL) {
+        AdicionarNosArvoreDecrescente(cat->indices[INDICE_PROTEINA], app->hwndListBox);
     }
 
     /* Rodape */
@@ -886,7 +866,7 @@ void OnIntervaloEnergia(AppData* app) {
     double max = 0.0;  // Energia maxima (kcal)
 
     /* Passo 1: Selecionar categoria */
-    if (!MostrarDialogoCategoria(app->hwndMain, app->lista_categorias, categoria)) {
+    if (!MostrarDialogoCategoria(app->hwndMain, app->base->lista_categorias, categoria)) {
         return;  // Cancelado
     }
 
@@ -904,7 +884,7 @@ void OnIntervaloEnergia(AppData* app) {
     }
 
     /* Buscar categoria */
-    NoCategoria* cat = buscar_categoria(app->lista_categorias, categoria);
+    NoCategoria* cat = buscar_categoria_registro(&app->base->categorias, categoria);
 
     if (cat == NULL) {
         MostrarMensagem(app->hwndMain, "Erro", "Categoria nao encontrada!");
@@ -936,9 +916,9 @@ void OnIntervaloEnergia(AppData* app) {
     AdicionarCabecalhoTabela(app->hwndListBox);
 
     /* Buscar na arvore valores no intervalo [min, max] */
-    /* Funcao recursiva otimizada que poda ramos desnecessarios */
-    if (cat->arvore_energia != NULL) {
-        AdicionarNosIntervalo(cat->arvore_energia, app->hwndListBox, min, max);
+    /* Cursor sem recursao: cursor_buscar desce ate min e cursor_proximo anda ate max */
+    if (cat->indices[INDICE_ENERGIA] != NULL) {
+        AdicionarNosIntervalo(cat->indices[INDICE_ENERGIA], app->hwndListBox, min, max);
     }
 
     /* Rodape */
@@ -961,7 +941,7 @@ void OnIntervaloEnergia(AppData* app) {
  * @param app: Ponteiro para dados da aplicacao
  *
  * FUNCIONAMENTO:
- * Identico a OnIntervaloEnergia, mas usa arvore_proteina.
+ * Identico a OnIntervaloEnergia, mas usa o indice de proteina.
  */
 void OnIntervaloProteina(AppData* app) {
     char categoria[MAX_CATEGORIA];
@@ -969,7 +949,7 @@ void OnIntervaloProteina(AppData* app) {
     double max = 0.0;  // Proteina maxima (g)
 
     /* Selecionar categoria */
-    if (!MostrarDialogoCategoria(app->hwndMain, app->lista_categorias, categoria)) {
+    if (!MostrarDialogoCategoria(app->hwndMain, app->base->lista_categorias, categoria)) {
         return;
     }
 
@@ -986,7 +966,7 @@ void OnIntervaloProteina(AppData* app) {
     }
 
     /* Buscar categoria */
-    NoCategoria* cat = buscar_categoria(app->lista_categorias, categoria);
+    NoCategoria* cat = buscar_categoria_registro(&app->base->categorias, categoria);
 
     if (cat == NULL) {
         MostrarMensagem(app->hwndMain, "Erro", "Categoria nao encontrada!");
@@ -1017,8 +997,8 @@ void OnIntervaloProteina(AppData* app) {
     AdicionarCabecalhoTabela(app->hwndListBox);
 
     /* Buscar na arvore de proteina valores no intervalo */
-    if (cat->arvore_proteina != NULL) {
-        AdicionarNosIntervalo(cat->arvore_proteina, app->hwndListBox, min, max);
+    if (cat->indices[INDICE_PROTEINA] != NULL) {
+        AdicionarNosIntervalo(cat->indices[INDICE_PROTEINA], app->hwndListBox, min, max);
     }
 
     /* Rodape */
@@ -1044,20 +1024,20 @@ void OnIntervaloProteina(AppData* app) {
  * FUNCIONAMENTO:
  * 1. Dialogo para selecionar categoria
  * 2. MessageBox para confirmar remocao
- * 3. Chama funcao remover_categoria (de categoria.c)
+ * 3. Chama funcao remover_categoria_da_base (de categoria.c)
  * 4. Marca dados como modificados
  * 5. Exibe mensagem de confirmacao
  *
  * IMPORTANTE:
  * - Remove categoria e TODOS os alimentos dela
- * - Libera memoria das arvores binarias e listas encadeadas
+ * - Os nos ficam na arena da base e sao liberados ao sair
  * - Marca dados_modificados = true para salvar ao sair
  */
 void OnRemoverCategoria(AppData* app) {
     char categoria[MAX_CATEGORIA];
 
     /* Selecionar categoria a remover */
-    if (!MostrarDialogoCategoria(app->hwndMain, app->lista_categorias, categoria)) {
+    if (!MostrarDialogoCategoria(app->hwndMain, app->base->lista_categorias, categoria)) {
         return;  // Cancelado
     }
 
@@ -1074,9 +1054,9 @@ void OnRemoverCategoria(AppData* app) {
         return;  // Usuario clicou Nao, cancelar operacao
     }
 
-    /* Remover categoria da lista */
-    /* remover_categoria retorna nova cabeca da lista (caso primeira categoria seja removida) */
-    app->lista_categorias = remover_categoria(app->lista_categorias, categoria);
+    /* Remover categoria do registro e da lista */
+    /* remover_categoria_da_base atualiza a cabeca da lista dentro da BaseDados */
+    remover_categoria_da_base(app->base, categoria);
 
     /* Marcar dados como modificados */
     /* Isso fara o sistema salvar automaticamente ao sair */
@@ -1113,28 +1093,23 @@ void OnRemoverCategoria(AppData* app) {
  * @param app: Ponteiro para dados da aplicacao
  *
  * FUNCIONAMENTO:
- * 1. Dialogo para selecionar categoria
- * 2. Dialogo para digitar numero do alimento
- * 3. Busca nome do alimento para exibir na confirmacao
- * 4. MessageBox para confirmar remocao
- * 5. Chama funcao remover_alimento_de_categoria
- * 6. Atualiza arvores binarias automaticamente
- * 7. Marca dados como modificados
+ * 1. Dialogo para digitar numero do alimento
+ * 2. Busca alimento e categoria no indice por numero (O(1))
+ * 3. MessageBox para confirmar remocao
+ * 4. Chama funcao remover_alimento_da_base
+ * 5. Marca dados como modificados
  *
  * IMPORTANTE:
- * - Remove alimento da lista encadeada
- * - Remove alimento das arvores de energia e proteina
+ * - Nao e preciso escolher a categoria: o indice sabe onde o alimento esta
+ * - Desmarca a linha do alimento na tabela colunar (bitmap de presenca)
+ * - Remove alimento dos indices da categoria e dos globais, do indice por
+ *   numero e das estatisticas da categoria
  * - Marca dados_modificados = true para salvar ao sair
  */
 void OnRemoverAlimento(AppData* app) {
     char categoria[MAX_CATEGORIA];
     double numero_double = 0.0;  // Usamos double pois dialogo retorna double
 
-    /* Selecionar categoria */
-    if (!MostrarDialogoCategoria(app->hwndMain, app->lista_categorias, categoria)) {
-        return;
-    }
-
     /* Perguntar numero do alimento */
     if (!MostrarDialogoNumero(app->hwndMain, "Numero do Alimento",
             "Digite o numero do alimento a remover:", &numero_double)) {
@@ -1144,27 +1119,18 @@ void OnRemoverAlimento(AppData* app) {
     /* Converter double para int */
     int numero = (int)numero_double;
 
-    /* Buscar categoria */
-    NoCategoria* cat = buscar_categoria(app->lista_categorias, categoria);
+    /* Buscar alimento e sua categoria pelo numero */
+    const EntradaNumero* entrada = buscar_indice_numero(&app->base->numeros, numero);
 
-    if (cat == NULL) {
-        MostrarMensagem(app->hwndMain, "Erro", "Categoria nao encontrada!");
+    if (entrada == NULL) {
+        MostrarMensagem(app->hwndMain, "Erro", "Alimento nao encontrado!");
         return;
     }
 
-    /* Buscar nome do alimento para mostrar na confirmacao */
-    /* Percorre lista de alimentos procurando pelo numero */
-    NoAlimento* alim = cat->lista_alimentos;
-    char nome_alimento[MAX_DESCRICAO] = "Alimento nao encontrado";  // Valor padrao se nao achar
-
-    while (alim != NULL) {
-        if (alim->numero == numero) {
-            /* Encontrou! Copiar nome */
-            strcpy(nome_alimento, alim->descricao);
-            break;  // Sair do loop
-        }
-        alim = alim->proximo;  // Proximo alimento
-    }
+    /* Copiar nomes antes da remocao (truncando se forem maiores que o buffer) */
+    char nome_alimento[MAX_DESCRICAO];
+    snprintf(nome_alimento, sizeof(nome_alimento), "%s", entrada->alimento->descricao);
+    snprintf(categoria, sizeof(categoria), "%s", entrada->categoria->nome);
 
     /* Mensagem de confirmacao com dados do alimento */
     char mensagem[512];
@@ -1178,8 +1144,8 @@ void OnRemoverAlimento(AppData* app) {
     }
 
     /* Remover alimento */
-    /* Funcao remove da lista e das arvores automaticamente */
-    remover_alimento_de_categoria(cat, numero);
+    /* Funcao remove da lista, das arvores e do indice automaticamente */
+    remover_alimento_da_base(app->base, numero);
 
     /* Marcar dados como modificados */
     app->dados_modificados = true;
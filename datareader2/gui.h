@@ -20,7 +20,7 @@
 
 /* Estrutura global para compartilhar dados entre funcoes */
 typedef struct {
-    NoCategoria* lista_categorias;
+    BaseDados* base;               /* categorias, registro e nos carregados */
     HWND hwndMain;
     HWND hwndListBox;
     HWND hwndStatus;
@@ -0,0 +1,123 @@
+#include "indice_numero.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CAPACIDADE_MINIMA_INDICE 64
+
+/* Hash multiplicativo (Fibonacci) do numero; os bits altos do produto sao
+ * misturados nos baixos, que escolhem a posicao */
+static size_t hash_numero(int numero) {
+    uint32_t produto = (uint32_t)numero * 2654435769u;
+    return (size_t)(produto ^ (produto >> 16));
+}
+
+/* Posicao da tabela onde o numero esta ou deveria estar (sondagem linear) */
+static size_t localizar(const IndiceNumero* indice, int numero) {
+    size_t mascara = indice->capacidade - 1;
+    size_t posicao = hash_numero(numero) & mascara;
+    while (indice->tabela[posicao].alimento != NULL &&
+           indice->tabela[posicao].alimento->numero != numero) {
+        posicao = (posicao + 1) & mascara;
+    }
+    return posicao;
+}
+
+/* Aloca uma tabela vazia com a capacidade indicada */
+static void alocar_tabela(IndiceNumero* indice, size_t capacidade) {
+    indice->tabela = (EntradaNumero*)calloc(capacidade, sizeof(EntradaNumero));
+    if (indice->tabela == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para o indice de alimentos.\n");
+        exit(1);
+    }
+    indice->capacidade = capacidade;
+}
+
+/* Dobra a tabela e reinsere as entradas */
+static void crescer_tabela(IndiceNumero* indice) {
+    EntradaNumero* antiga = indice->tabela;
+    size_t capacidade_antiga = indice->capacidade;
+
+    alocar_tabela(indice, capacidade_antiga * 2);
+    for (size_t i = 0; i < capacidade_antiga; i++) {
+        if (antiga[i].alimento != NULL) {
+            indice->tabela[localizar(indice, antiga[i].alimento->numero)] = antiga[i];
+        }
+    }
+    free(antiga);
+}
+
+/* Prepara um indice vazio com espaco para a quantidade esperada de alimentos */
+void inicializar_indice_numero(IndiceNumero* indice, size_t total_esperado) {
+    memset(indice, 0, sizeof(IndiceNumero));
+
+    /* Mantem a ocupacao abaixo de 50% */
+    size_t capacidade = CAPACIDADE_MINIMA_INDICE;
+    while (capacidade < total_esperado * 2) {
+        capacidade *= 2;
+    }
+    alocar_tabela(indice, capacidade);
+}
+
+/* Indexa um alimento pelo numero; retorna false se o numero ja estiver no indice */
+bool inserir_indice_numero(IndiceNumero* indice, NoAlimento* alimento, NoCategoria* categoria) {
+    if ((indice->total + 1) * 2 > indice->capacidade) {
+        crescer_tabela(indice);
+    }
+
+    size_t posicao = localizar(indice, alimento->numero);
+    if (indice->tabela[posicao].alimento != NULL) {
+        return false;
+    }
+    indice->tabela[posicao].alimento = alimento;
+    indice->tabela[posicao].categoria = categoria;
+    indice->total++;
+    return true;
+}
+
+/* Busca um alimento pelo numero em O(1); retorna NULL se nao existir */
+const EntradaNumero* buscar_indice_numero(const IndiceNumero* indice, int numero) {
+    if (indice->tabela == NULL) {
+        return NULL;
+    }
+    const EntradaNumero* entrada = &indice->tabela[localizar(indice, numero)];
+    return entrada->alimento != NULL ? entrada : NULL;
+}
+
+/* Retira um numero do indice.
+ * As entradas seguintes da mesma sequencia de sondagem sao puxadas para tras,
+ * para que a tabela continue sem marcas de remocao. */
+bool remover_indice_numero(IndiceNumero* indice, int numero) {
+    if (indice->tabela == NULL) {
+        return false;
+    }
+
+    size_t mascara = indice->capacidade - 1;
+    size_t vazia = localizar(indice, numero);
+    if (indice->tabela[vazia].alimento == NULL) {
+        return false;
+    }
+    indice->tabela[vazia].alimento = NULL;
+    indice->tabela[vazia].categoria = NULL;
+    indice->total--;
+
+    size_t atual = (vazia + 1) & mascara;
+    while (indice->tabela[atual].alimento != NULL) {
+        size_t ideal = hash_numero(indice->tabela[atual].alimento->numero) & mascara;
+        /* A entrada pode ocupar a posicao vazia se ela estiver entre a ideal e a atual */
+        if (((atual - ideal) & mascara) >= ((atual - vazia) & mascara)) {
+            indice->tabela[vazia] = indice->tabela[atual];
+            indice->tabela[atual].alimento = NULL;
+            indice->tabela[atual].categoria = NULL;
+            vazia = atual;
+        }
+        atual = (atual + 1) & mascara;
+    }
+    return true;
+}
+
+/* Libera a tabela do indice */
+void liberar_indice_numero(IndiceNumero* indice) {
+    free(indice->tabela);
+    memset(indice, 0, sizeof(IndiceNumero));
+}
@@ -0,0 +1,21 @@
+#ifndef INDICE_NUMERO_H
+#define INDICE_NUMERO_H
+
+#include "tipos.h"
+
+/* Prepara um indice vazio com espaco para a quantidade esperada de alimentos */
+void inicializar_indice_numero(IndiceNumero* indice, size_t total_esperado);
+
+/* Indexa um alimento pelo numero; retorna false se o numero ja estiver no indice */
+bool inserir_indice_numero(IndiceNumero* indice, NoAlimento* alimento, NoCategoria* categoria);
+
+/* Busca um alimento pelo numero em O(1); retorna NULL se nao existir */
+const EntradaNumero* buscar_indice_numero(const IndiceNumero* indice, int numero);
+
+/* Retira um numero do indice; retorna false se ele nao existir */
+bool remover_indice_numero(IndiceNumero* indice, int numero);
+
+/* Libera a tabela do indice */
+void liberar_indice_numero(IndiceNumero* indice);
+
+#endif
@@ -0,0 +1,126 @@
+#define _POSIX_C_SOURCE 200809L
+#include "indice_plano.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+/* Posicoes de eytzinger por linha de cache (8 doubles de 64 bytes) */
+#define CHAVES_POR_LINHA 8
+#define TAMANHO_LINHA_CACHE 64
+
+/* Aloca o vetor de eytzinger alinhado a linha de cache, para que as posicoes
+ * 8k..8k+7 caiam sempre na mesma linha. Liberar com liberar_alinhado. */
+static double* alocar_alinhado(size_t total) {
+#ifdef _WIN32
+    return (double*)_aligned_malloc(total * sizeof(double), TAMANHO_LINHA_CACHE);
+#else
+    void* memoria;
+    return posix_memalign(&memoria, TAMANHO_LINHA_CACHE, total * sizeof(double)) == 0 ? (double*)memoria : NULL;
+#endif
+}
+
+/* Libera um vetor de alocar_alinhado */
+static void liberar_alinhado(double* vetor) {
+#ifdef _WIN32
+    _aligned_free(vetor);
+#else
+    free(vetor);
+#endif
+}
+
+/* Preenche eytzinger[k] percorrendo a arvore implicita em ordem:
+ * a i-esima posicao visitada recebe a i-esima menor chave */
+static size_t preencher_eytzinger(IndicePlano* indice, size_t i, size_t k) {
+    if (k <= indice->total) {
+        i = preencher_eytzinger(indice, i, 2 * k);
+        indice->eytzinger[k] = indice->chaves[i];
+        indice->posicao[k] = i;
+        i++;
+        i = preencher_eytzinger(indice, i, 2 * k + 1);
+    }
+    return i;
+}
+
+/* Constroi o indice a partir das entradas (que sao ordenadas no lugar) */
+bool construir_indice_plano(IndicePlano* indice, EntradaArvore* entradas, size_t total) {
+    memset(indice, 0, sizeof(IndicePlano));
+    indice->total = total;
+    indice->chaves = (double*)malloc((total > 0 ? total : 1) * sizeof(double));
+    indice->alimentos = (NoAlimento**)malloc((total > 0 ? total : 1) * sizeof(NoAlimento*));
+    indice->eytzinger = alocar_alinhado(total + 1);
+    indice->posicao = (size_t*)malloc((total + 1) * sizeof(size_t));
+    if (indice->chaves == NULL || indice->alimentos == NULL ||
+        indice->eytzinger == NULL || indice->posicao == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para o indice plano.\n");
+        liberar_indice_plano(indice);
+        return false;
+    }
+
+    ordenar_entradas_arvore(entradas, total);
+    for (size_t i = 0; i < total; i++) {
+        indice->chaves[i] = entradas[i].chave;
+        indice->alimentos[i] = entradas[i].alimento;
+    }
+
+    indice->eytzinger[0] = 0.0;
+    indice->posicao[0] = total;
+    preencher_eytzinger(indice, 0, 1);
+    return true;
+}
+
+/* Retorna o indice (na ordem crescente) da primeira chave >= chave */
+size_t limite_inferior_plano(const IndicePlano* indice, double chave) {
+    size_t k = 1;
+
+    /* Desce a arvore implicita sem desvios: o filho e 2k ou 2k+1 conforme a
+     * comparacao. Os 8 descendentes tres geracoes abaixo (8k..8k+7) ocupam
+     * uma linha de cache do vetor alinhado, antecipada a cada iteracao.
+     * Perto das folhas essa posicao passa do fim do vetor; o endereco entao
+     * volta para o inicio, para nunca apontar para fora da alocacao. */
+    while (k <= indice->total) {
+#ifdef __GNUC__
+        size_t adiante = k * CHAVES_POR_LINHA;
+        __builtin_prefetch(indice->eytzinger + (adiante <= indice->total ? adiante : 0));
+#endif
+        k = 2 * k + (indice->eytzinger[k] < chave);
+    }
+
+    /* Desfaz as descidas a direita feitas depois da ultima descida a esquerda */
+#ifdef __GNUC__
+    k >>= __builtin_ffsll((long long)~k);
+#else
+    while (k & 1) {
+        k >>= 1;
+    }
+    k >>= 1;
+#endif
+
+    return indice->posicao[k];
+}
+
+/* Lista os alimentos em ordem decrescente da chave */
+void percorrer_plano_decrescente(const IndicePlano* indice) {
+    for (size_t i = indice->total; i > 0; i--) {
+        imprimir_alimento_listagem(indice->alimentos[i - 1]);
+    }
+}
+
+/* Lista os alimentos com chave em [min, max] */
+void percorrer_plano_intervalo(const IndicePlano* indice, double min, double max) {
+    for (size_t i = limite_inferior_plano(indice, min); i < indice->total && indice->chaves[i] <= max; i++) {
+        imprimir_alimento_listagem(indice->alimentos[i]);
+    }
+}
+
+/* Libera os vetores do indice */
+void liberar_indice_plano(IndicePlano* indice) {
+    free(indice->chaves);
+    free(indice->alimentos);
+    liberar_alinhado(indice->eytzinger);
+    free(indice->posicao);
+    memset(indice, 0, sizeof(IndicePlano));
+}
@@ -0,0 +1,37 @@
+#ifndef INDICE_PLANO_H
+#define INDICE_PLANO_H
+
+#include "tipos.h"
+#include "arvore.h"
+
+/* Indice plano por uma chave numerica (alternativa as arvores de NoArvore).
+ * As chaves ficam em vetores contiguos:
+ *   - chaves/alimentos: ordem crescente, para varreduras sequenciais;
+ *   - eytzinger: as mesmas chaves em ordem de busca em largura (posicoes
+ *     1..total), para uma busca binaria sem desvios e com prefetch;
+ *   - posicao: para cada posicao de eytzinger, o indice na ordem crescente. */
+typedef struct {
+    size_t total;
+    double* chaves;
+    NoAlimento** alimentos;
+    double* eytzinger;
+    size_t* posicao;
+} IndicePlano;
+
+/* Constroi o indice a partir das entradas (que sao ordenadas no lugar) */
+bool construir_indice_plano(IndicePlano* indice, EntradaArvore* entradas, size_t total);
+
+/* Retorna o indice (na ordem crescente) da primeira chave >= chave,
+ * ou total se todas forem menores */
+size_t limite_inferior_plano(const IndicePlano* indice, double chave);
+
+/* Lista os alimentos em ordem decrescente da chave (mesma saida de percorrer_decrescente) */
+void percorrer_plano_decrescente(const IndicePlano* indice);
+
+/* Lista os alimentos com chave em [min, max] (mesma saida de percorrer_intervalo) */
+void percorrer_plano_intervalo(const IndicePlano* indice, double min, double max);
+
+/* Libera os vetores do indice */
+void liberar_indice_plano(IndicePlano* indice);
+
+#endif
@@ -0,0 +1,237 @@
+#include "indices.h"
+#include "arena.h"
+#include "arvore.h"
+#include "melhores.h"
+#include "tabela.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Acrescenta uma definicao ao registro; retorna o numero ou -1 se cheio.
+ * Guarda os ponteiros de nome e unidade, que devem durar tanto quanto ele. */
+static int adicionar_definicao(RegistroIndices* indices, const char* nome, const char* unidade,
+                               MetricaLinha chave, EscopoIndice escopo) {
+    if (indices->total >= MAX_INDICES) {
+        fprintf(stderr, "Limite de %d indices atingido; indice '%s' nao criado.\n", MAX_INDICES, nome);
+        return -1;
+    }
+
+    DefinicaoIndice* definicao = &indices->definicoes[indices->total];
+    definicao->nome = nome;
+    definicao->unidade = unidade;
+    definicao->chave = chave;
+    definicao->escopo = escopo;
+    indices->globais[indices->total] = NULL;
+    return (int)indices->total++;
+}
+
+/* Prepara o registro com os indices padrao, sem arvores */
+void inicializar_indices(RegistroIndices* indices) {
+    memset(indices, 0, sizeof(RegistroIndices));
+    adicionar_definicao(indices, "Umidade", "%", metrica_umidade, ESCOPO_CATEGORIA);
+    adicionar_definicao(indices, "Energia", "kcal", metrica_energia, ESCOPO_CATEGORIA);
+    adicionar_definicao(indices, "Proteina", "g", metrica_proteina, ESCOPO_CATEGORIA);
+    adicionar_definicao(indices, "Carboidrato", "g", metrica_carboidrato, ESCOPO_CATEGORIA);
+    adicionar_definicao(indices, "Energia/proteina", "kcal/g", metrica_energia_proteina, ESCOPO_CATEGORIA);
+    adicionar_definicao(indices, "Energia/carboidrato", "kcal/g", metrica_energia_carboidrato, ESCOPO_CATEGORIA);
+    adicionar_definicao(indices, "Energia (global)", "kcal", metrica_energia, ESCOPO_GLOBAL);
+    adicionar_definicao(indices, "Proteina (global)", "g", metrica_proteina, ESCOPO_GLOBAL);
+}
+
+/* Numero do indice global com a chave dada, ou -1 se nao houver */
+int indice_global_da_chave(const RegistroIndices* indices, MetricaLinha chave) {
+    for (size_t i = 0; i < indices->total; i++) {
+        if (indices->definicoes[i].escopo == ESCOPO_GLOBAL && indices->definicoes[i].chave == chave) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/* Consulta de faixa em um indice global. O cursor desce uma vez ate a
+ * ponta da faixa e anda pelos nos vizinhos; a categoria, se dada, e
+ * conferida em cada no visitado, sem varrer outras arvores. */
+size_t consultar_indice_global(const RegistroIndices* indices, int indice, double min, double max,
+                               const NoCategoria* categoria, bool decrescente,
+                               NoAlimento** saida, size_t limite) {
+    if (indice < 0 || (size_t)indice >= indices->total ||
+        indices->definicoes[indice].escopo != ESCOPO_GLOBAL) {
+        return 0;
+    }
+
+    CursorArvore cursor;
+    if (decrescente) {
+        cursor_buscar_ate(&cursor, indices->globais[indice], max);
+    } else {
+        cursor_buscar(&cursor, indices->globais[indice], min);
+    }
+
+    size_t total = 0;
+    for (NoArvore* no = cursor_atual(&cursor); no != NULL && total < limite; no = cursor_atual(&cursor)) {
+        if (decrescente ? no->chave < min : no->chave > max) {
+            break;
+        }
+        if (categoria == NULL || no->alimento->categoria == categoria) {
+            saida[total++] = no->alimento;
+        }
+        if (decrescente) {
+            cursor_anterior(&cursor);
+        } else {
+            cursor_proximo(&cursor);
+        }
+    }
+    return total;
+}
+
+/* Aloca o vetor de entradas para a construcao de ate total arvores */
+static EntradaArvore* alocar_entradas(size_t total) {
+    EntradaArvore* entradas = (EntradaArvore*)malloc((total > 0 ? total : 1) * sizeof(EntradaArvore));
+    if (entradas == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para construir os indices.\n");
+        exit(1);
+    }
+    return entradas;
+}
+
+/* Preenche as entradas com a chave das linhas presentes de [inicio, fim),
+ * a partir de entradas[total]; retorna o novo total. A posicao e a linha:
+ * chaves iguais ficam na ordem da tabela, o que a remocao usa para descer
+ * direto ate o no (ver remover_da_arvore). */
+static size_t preencher_entradas(const TabelaAlimentos* tabela, size_t inicio, size_t fim,
+                                 MetricaLinha chave, EntradaArvore* entradas, size_t total) {
+    for (size_t linha = proxima_linha(tabela, inicio, fim); linha < fim;
+         linha = proxima_linha(tabela, linha + 1, fim), total++) {
+        entradas[total].chave = chave(tabela, linha);
+        entradas[total].alimento = tabela->alimento[linha];
+        entradas[total].posicao = linha;
+    }
+    return total;
+}
+
+/* Monta a arvore de um indice por categoria em uma categoria */
+static void construir_arvore_categoria(Arena* arena, const TabelaAlimentos* tabela, const DefinicaoIndice* definicao,
+                                       NoCategoria* categoria, NoArvore** arvore, EntradaArvore* entradas) {
+    const ParticaoTabela* particao = particao_categoria(tabela, categoria);
+    size_t total = preencher_entradas(tabela, particao->inicio, particao->fim, definicao->chave, entradas, 0);
+    *arvore = total > 0 ? construir_arvore_balanceada(arena, entradas, total) : NULL;
+}
+
+/* Monta a arvore de um indice global com as linhas presentes de todas as
+ * categorias carregadas */
+static NoArvore* construir_arvore_global(Arena* arena, const TabelaAlimentos* tabela, const DefinicaoIndice* definicao,
+                                         EntradaArvore* entradas) {
+    size_t total = 0;
+    for (size_t p = 0; p < tabela->total_particoes; p++) {
+        const ParticaoTabela* particao = &tabela->particoes[p];
+        if (particao->categoria != NULL) {
+            total = preencher_entradas(tabela, particao->inicio, particao->fim, definicao->chave, entradas, total);
+        }
+    }
+    return total > 0 ? construir_arvore_balanceada(arena, entradas, total) : NULL;
+}
+
+/* Constroi as arvores de todos os indices por categoria de uma categoria.
+ * As chaves vem das linhas presentes da particao (ja em ordem de
+ * descricao); cada arvore e ordenada uma vez e montada ja balanceada, com
+ * os nos alocados em sequencia na arena. */
+void construir_indices_categoria(Arena* arena, const TabelaAlimentos* tabela,
+                                 const RegistroIndices* indices, NoCategoria* categoria) {
+    if (categoria == NULL) {
+        return;
+    }
+
+    const ParticaoTabela* particao = particao_categoria(tabela, categoria);
+    EntradaArvore* entradas = alocar_entradas(contar_linhas(tabela, particao->inicio, particao->fim));
+    for (size_t i = 0; i < indices->total; i++) {
+        categoria->indices[i] = NULL;
+        if (indices->definicoes[i].escopo == ESCOPO_CATEGORIA) {
+            construir_arvore_categoria(arena, tabela, &indices->definicoes[i], categoria,
+                                       &categoria->indices[i], entradas);
+        }
+    }
+    free(entradas);
+}
+
+/* Constroi as arvores de todos os indices globais */
+void construir_indices_globais(Arena* arena, const TabelaAlimentos* tabela, RegistroIndices* indices) {
+    EntradaArvore* entradas = NULL;
+    for (size_t i = 0; i < indices->total; i++) {
+        if (indices->definicoes[i].escopo == ESCOPO_GLOBAL) {
+            if (entradas == NULL) {
+                entradas = alocar_entradas(tabela->presentes);
+            }
+            indices->globais[i] = construir_arvore_global(arena, tabela, &indices->definicoes[i], entradas);
+        }
+    }
+    free(entradas);
+}
+
+/* Copia um texto para a arena, onde fica enquanto a base existir */
+static const char* copiar_na_arena(Arena* arena, const char* texto) {
+    size_t tamanho = strlen(texto) + 1;
+    char* copia = (char*)alocar_na_arena(arena, tamanho);
+    memcpy(copia, texto, tamanho);
+    return copia;
+}
+
+/* Declara um novo indice na base ja carregada e constroi suas arvores:
+ * em cada categoria da lista, ou uma so sobre a tabela inteira. O nome e
+ * a unidade podem vir de um buffer de quem chama, entao o registro guarda
+ * copias na arena. Retorna o numero do indice, ou -1 se o registro estiver
+ * cheio. */
+int declarar_indice(BaseDados* base, const char* nome, const char* unidade,
+                    MetricaLinha chave, EscopoIndice escopo) {
+    int indice = adicionar_definicao(&base->indices, copiar_na_arena(&base->arena, nome),
+                                     copiar_na_arena(&base->arena, unidade), chave, escopo);
+    if (indice < 0) {
+        return -1;
+    }
+
+    const DefinicaoIndice* definicao = &base->indices.definicoes[indice];
+    const TabelaAlimentos* tabela = &base->tabela;
+    EntradaArvore* entradas = alocar_entradas(tabela->presentes);
+    if (escopo == ESCOPO_GLOBAL) {
+        base->indices.globais[indice] = construir_arvore_global(&base->arena, tabela, definicao, entradas);
+    } else {
+        for (NoCategoria* categoria = base->lista_categorias; categoria != NULL; categoria = categoria->proximo) {
+            construir_arvore_categoria(&base->arena, tabela, definicao, categoria,
+                                       &categoria->indices[indice], entradas);
+        }
+    }
+    free(entradas);
+    return indice;
+}
+
+/* Retira um alimento de todos os indices (da sua categoria e globais).
+ * A chave e recalculada da linha, que continua na tabela mesmo depois de
+ * marcada como removida. */
+void remover_alimento_dos_indices(const TabelaAlimentos* tabela, RegistroIndices* indices,
+                                  NoCategoria* categoria, NoAlimento* alimento) {
+    for (size_t i = 0; i < indices->total; i++) {
+        const DefinicaoIndice* definicao = &indices->definicoes[i];
+        double chave = definicao->chave(tabela, alimento->linha);
+        if (definicao->escopo == ESCOPO_GLOBAL) {
+            indices->globais[i] = remover_da_arvore(indices->globais[i], chave, alimento);
+        } else {
+            categoria->indices[i] = remover_da_arvore(categoria->indices[i], chave, alimento);
+        }
+    }
+}
+
+/* Retira dos indices globais os alimentos de uma categoria. As arvores da
+ * propria categoria ficam na arena, junto com o no da categoria. */
+void remover_categoria_dos_indices(const TabelaAlimentos* tabela, RegistroIndices* indices,
+                                   const NoCategoria* categoria) {
+    const ParticaoTabela* particao = particao_categoria(tabela, categoria);
+    for (size_t i = 0; i < indices->total; i++) {
+        const DefinicaoIndice* definicao = &indices->definicoes[i];
+        if (definicao->escopo != ESCOPO_GLOBAL) {
+            continue;
+        }
+        for (size_t linha = proxima_linha(tabela, particao->inicio, particao->fim); linha < particao->fim;
+             linha = proxima_linha(tabela, linha + 1, particao->fim)) {
+            indices->globais[i] = remover_da_arvore(indices->globais[i], definicao->chave(tabela, linha),
+                                                    tabela->alimento[linha]);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef INDICES_H
+#define INDICES_H
+
+#include "tipos.h"
+
+/* Indices secundarios: arvores AVL sobre qualquer coluna ou expressao da
+ * tabela (uma MetricaLinha), declaradas em um registro e mantidas pela
+ * base. Um indice por categoria tem uma arvore em cada NoCategoria
+ * (indices[numero]); um indice global tem uma so arvore no registro
+ * (globais[numero]). As arvores sao montadas ao carregar (ou ao declarar)
+ * e atualizadas a cada remocao. */
+
+/* Indices padrao, declarados em todo registro nesta ordem: os nutrientes
+ * tem o mesmo numero da sua ColunaNutriente; energia e proteina tem tambem
+ * um indice global, para consultas sobre a base inteira */
+typedef enum {
+    INDICE_UMIDADE = COLUNA_UMIDADE,
+    INDICE_ENERGIA = COLUNA_ENERGIA,
+    INDICE_PROTEINA = COLUNA_PROTEINA,
+    INDICE_CARBOIDRATO = COLUNA_CARBOIDRATO,
+    INDICE_ENERGIA_PROTEINA,
+    INDICE_ENERGIA_CARBOIDRATO,
+    INDICE_ENERGIA_GLOBAL,
+    INDICE_PROTEINA_GLOBAL,
+    TOTAL_INDICES_PADRAO
+} IndicePadrao;
+
+/* Prepara o registro com os indices padrao, sem arvores */
+void inicializar_indices(RegistroIndices* indices);
+
+/* Numero do indice global com a chave dada, ou -1 se nao houver */
+int indice_global_da_chave(const RegistroIndices* indices, MetricaLinha chave);
+
+/* Consulta de faixa em um indice global: grava em saida (espaco para
+ * limite) os alimentos com chave em [min, max], em ordem crescente ou
+ * decrescente da chave, e retorna quantos gravou. Com categoria, so os
+ * dessa categoria entram (filtro durante a varredura); sem ela (NULL), a
+ * consulta custa O(log n + k). */
+size_t consultar_indice_global(const RegistroIndices* indices, int indice, double min, double max,
+                               const NoCategoria* categoria, bool decrescente,
+                               NoAlimento** saida, size_t limite);
+
+/* Declara um novo indice na base ja carregada e constroi suas arvores.
+ * O nome e a unidade sao copiados para a arena da base.
+ * Retorna o numero do indice, ou -1 se o registro estiver cheio. */
+int declarar_indice(BaseDados* base, const char* nome, const char* unidade,
+                    MetricaLinha chave, EscopoIndice escopo);
+
+/* Constroi as arvores de todos os indices por categoria de uma categoria */
+void construir_indices_categoria(Arena* arena, const TabelaAlimentos* tabela,
+                                 const RegistroIndices* indices, NoCategoria* categoria);
+
+/* Constroi as arvores de todos os indices globais */
+void construir_indices_globais(Arena* arena, const TabelaAlimentos* tabela, RegistroIndices* indices);
+
+/* Retira um alimento de todos os indices (da sua categoria e globais) */
+void remover_alimento_dos_indices(const TabelaAlimentos* tabela, RegistroIndices* indices,
+                                  NoCategoria* categoria, NoAlimento* alimento);
+
+/* Retira dos indices globais os alimentos de uma categoria; deve ser
+ * chamada antes das linhas sairem da tabela */
+void remover_categoria_dos_indices(const TabelaAlimentos* tabela, RegistroIndices* indices,
+                                   const NoCategoria* categoria);
+
+#endif
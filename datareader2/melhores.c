@@ -0,0 +1,129 @@
+#include "melhores.h"
+#include "tabela.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Candidato no heap: valor da metrica e linha (que desempata) */
+typedef struct {
+    double valor;
+    size_t linha;
+} Candidato;
+
+/* Metricas prontas sobre as colunas da tabela */
+double metrica_umidade(const TabelaAlimentos* tabela, size_t linha) {
+    return tabela->umidade[linha];
+}
+
+double metrica_energia(const TabelaAlimentos* tabela, size_t linha) {
+    return (double)tabela->energia_kcal[linha];
+}
+
+double metrica_proteina(const TabelaAlimentos* tabela, size_t linha) {
+    return tabela->proteina[linha];
+}
+
+double metrica_carboidrato(const TabelaAlimentos* tabela, size_t linha) {
+    return tabela->carboidrato[linha];
+}
+
+double metrica_energia_proteina(const TabelaAlimentos* tabela, size_t linha) {
+    double proteina = tabela->proteina[linha];
+    return proteina > 0.0 ? (double)tabela->energia_kcal[linha] / proteina : 0.0;
+}
+
+double metrica_energia_carboidrato(const TabelaAlimentos* tabela, size_t linha) {
+    double carboidrato = tabela->carboidrato[linha];
+    return carboidrato > 0.0 ? (double)tabela->energia_kcal[linha] / carboidrato : 0.0;
+}
+
+/* a e pior que b: menor valor, ou mesmo valor e linha posterior */
+static int pior(const Candidato* a, const Candidato* b) {
+    if (a->valor != b->valor) {
+        return a->valor < b->valor;
+    }
+    return a->linha > b->linha;
+}
+
+/* Desce o candidato da posicao i; o pior do heap fica na raiz */
+static void descer(Candidato* heap, size_t tamanho, size_t i) {
+    for (;;) {
+        size_t alvo = i;
+        size_t esquerda = 2 * i + 1;
+        size_t direita = esquerda + 1;
+        if (esquerda < tamanho && pior(&heap[esquerda], &heap[alvo])) {
+            alvo = esquerda;
+        }
+        if (direita < tamanho && pior(&heap[direita], &heap[alvo])) {
+            alvo = direita;
+        }
+        if (alvo == i) {
+            return;
+        }
+        Candidato temp = heap[i];
+        heap[i] = heap[alvo];
+        heap[alvo] = temp;
+        i = alvo;
+    }
+}
+
+/* Sobe o candidato da posicao i enquanto for pior que o pai */
+static void subir(Candidato* heap, size_t i) {
+    while (i > 0) {
+        size_t pai = (i - 1) / 2;
+        if (!pior(&heap[i], &heap[pai])) {
+            return;
+        }
+        Candidato temp = heap[i];
+        heap[i] = heap[pai];
+        heap[pai] = temp;
+        i = pai;
+    }
+}
+
+/* Seleciona as n linhas presentes de [inicio, fim) com maior metrica, com
+ * um heap limitado a n (o pior dos guardados na raiz): cada linha custa
+ * uma comparacao com a raiz e, se entrar, O(log n). Grava as linhas em
+ * saida da melhor para a pior e retorna quantas foram gravadas. */
+size_t selecionar_melhores(const TabelaAlimentos* tabela, size_t inicio, size_t fim,
+                           MetricaLinha metrica, size_t n, size_t* saida) {
+    if (n == 0 || inicio >= fim) {
+        return 0;
+    }
+    if (n > fim - inicio) {
+        n = fim - inicio;
+    }
+
+    Candidato* heap = (Candidato*)malloc(n * sizeof(Candidato));
+    if (heap == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para a selecao\n");
+        exit(1);
+    }
+
+    size_t tamanho = 0;
+    size_t l;
+    for (l = proxima_linha(tabela, inicio, fim); l < fim; l = proxima_linha(tabela, l + 1, fim)) {
+        Candidato candidato;
+        candidato.valor = metrica(tabela, l);
+        candidato.linha = l;
+        if (tamanho < n) {
+            heap[tamanho] = candidato;
+            subir(heap, tamanho);
+            tamanho++;
+        } else if (pior(&heap[0], &candidato)) {
+            heap[0] = candidato;
+            descer(heap, tamanho, 0);
+        }
+    }
+
+    /* O pior sai primeiro: preenche a saida de tras para frente */
+    size_t total = tamanho;
+    while (tamanho > 0) {
+        saida[tamanho - 1] = heap[0].linha;
+        tamanho--;
+        heap[0] = heap[tamanho];
+        descer(heap, tamanho, 0);
+    }
+
+    free(heap);
+    return total;
+}
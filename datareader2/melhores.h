@@ -0,0 +1,23 @@
+#ifndef MELHORES_H
+#define MELHORES_H
+
+#include "tipos.h"
+
+/* Metricas prontas (MetricaLinha, ver tipos.h; maior = melhor): os
+ * nutrientes e as razoes energia/proteina e energia/carboidrato (0 quando o
+ * divisor e 0). Sao tambem as chaves dos indices padrao (ver indices.h). */
+double metrica_umidade(const TabelaAlimentos* tabela, size_t linha);
+double metrica_energia(const TabelaAlimentos* tabela, size_t linha);
+double metrica_proteina(const TabelaAlimentos* tabela, size_t linha);
+double metrica_carboidrato(const TabelaAlimentos* tabela, size_t linha);
+double metrica_energia_proteina(const TabelaAlimentos* tabela, size_t linha);
+double metrica_energia_carboidrato(const TabelaAlimentos* tabela, size_t linha);
+
+/* Seleciona as n linhas presentes de [inicio, fim) com maior metrica, com
+ * um heap limitado a n: O(m log n) para m linhas, sem ordenar a faixa.
+ * Grava as linhas em saida (espaco para n) da melhor para a pior, com
+ * empates na ordem da tabela, e retorna quantas foram gravadas. */
+size_t selecionar_melhores(const TabelaAlimentos* tabela, size_t inicio, size_t fim,
+                           MetricaLinha metrica, size_t n, size_t* saida);
+
+#endif
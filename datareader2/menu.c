@@ -1,9 +1,27 @@
 #include "menu.h"
+#include "agregacao.h"
+#include "arvore_kd.h"
 #include "categoria.h"
 #include "arvore.h"
+#include "filtro.h"
+#include "indice_numero.h"
+#include "indices.h"
+#include "melhores.h"
+#include "ordem.h"
+#include "registro.h"
+#include "similares.h"
+#include "tabela.h"
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+/* Descarta o resto da linha digitada (ou ate o fim da entrada) */
+static void descartar_linha(void) {
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF);
+}
+
 /* Exibe o menu principal e retorna a opcao escolhida */
 int exibir_menu() {
     int opcao = 0;
@@ -20,25 +38,32 @@ int exibir_menu() {
     printf("7. Remover uma categoria\n");
     printf("8. Remover um alimento\n");
     printf("9. Sair\n");
+    printf("10. Filtrar alimentos por faixas de nutrientes\n");
+    printf("11. Estatisticas nutricionais por categoria\n");
+    printf("12. Listar os N melhores alimentos por uma metrica\n");
+    printf("13. Contagens e percentis por nutriente ou razao\n");
+    printf("14. Filtrar por faixas de nutrientes (arvore k-d)\n");
+    printf("15. Buscar alimentos similares\n");
     printf("========================================\n");
     printf("Escolha uma opcao: ");
 
-    if (scanf("%d", &opcao) != 1) {
-        while (getchar() != '\n');
-        return 0;
+    /* Fim da entrada: nao ha mais opcoes a ler, entao sai */
+    int lidos = scanf("%d", &opcao);
+    if (lidos == EOF) {
+        return OPCAO_SAIR;
     }
-    while (getchar() != '\n');
 
-    return opcao;
+    descartar_linha();
+    return lidos == 1 ? opcao : -1;
 }
 
 /* Executa a opcao 1: Listar todas as categorias */
-void opcao_listar_categorias(NoCategoria* lista) {
-    listar_categorias(lista);
+void opcao_listar_categorias(BaseDados* base) {
+    listar_categorias(base->lista_categorias);
 }
 
 /* Executa a opcao 2: Listar alimentos de uma categoria */
-void opcao_listar_alimentos(NoCategoria* lista) {
+void opcao_listar_alimentos(BaseDados* base) {
     char nome_categoria[MAX_CATEGORIA];
 
     printf("\nDigite o nome da categoria: ");
@@ -52,18 +77,20 @@ void opcao_listar_alimentos(NoCategoria* lista) {
         nome_categoria[len - 1] = '\0';
     }
 
-    NoCategoria* categoria = buscar_categoria(lista, nome_categoria);
-    listar_alimentos_categoria(categoria);
+    NoCategoria* categoria = buscar_categoria_registro(&base->categorias, nome_categoria);
+    listar_alimentos_categoria(&base->tabela, categoria);
 }
 
-/* Executa a opcao 3: Listar alimentos por energia (decrescente) */
-void opcao_listar_por_energia(NoCategoria* lista) {
+/* Le o nome da categoria de uma consulta (Enter para todas). Grava a
+ * categoria (NULL para todas) e o titulo da listagem; retorna false, ja
+ * avisado, se a entrada falhar ou a categoria nao existir. */
+static bool ler_categoria_opcional(BaseDados* base, NoCategoria** categoria, const char** titulo) {
     char nome_categoria[MAX_CATEGORIA];
 
-    printf("\nDigite o nome da categoria: ");
+    printf("\nDigite o nome da categoria (Enter para todas): ");
     if (fgets(nome_categoria, MAX_CATEGORIA, stdin) == NULL) {
         printf("Erro ao ler entrada.\n");
-        return;
+        return false;
     }
 
     size_t len = strlen(nome_categoria);
@@ -71,165 +98,213 @@ void opcao_listar_por_energia(NoCategoria* lista) {
         nome_categoria[len - 1] = '\0';
     }
 
-    NoCategoria* categoria = buscar_categoria(lista, nome_categoria);
-    if (categoria == NULL) {
-        printf("Categoria nao encontrada.\n");
-        return;
+    *categoria = NULL;
+    *titulo = "Todas as categorias";
+    if (nome_categoria[0] != '\0') {
+        *categoria = buscar_categoria_registro(&base->categorias, nome_categoria);
+        if (*categoria == NULL) {
+            printf("Categoria nao encontrada.\n");
+            return false;
+        }
+        *titulo = (*categoria)->nome;
     }
+    return true;
+}
 
-    if (categoria->arvore_energia == NULL) {
-        printf("Nenhum alimento nesta categoria.\n");
-        return;
+/* Le a faixa "min max" de um nutriente; linha vazia ignora o nutriente.
+ * Retorna 1 se leu a faixa, 0 se ela foi ignorada e -1 se a entrada for invalida. */
+static int ler_faixa(const char* nutriente, const char* unidade, double* min, double* max) {
+    char linha[128];
+
+    printf("Faixa de %s em %s (min max, Enter para ignorar): ", nutriente, unidade);
+    if (fgets(linha, sizeof(linha), stdin) == NULL) {
+        return -1;
+    }
+    if (linha[strspn(linha, " \t\r\n")] == '\0') {
+        return 0;
     }
+    if (sscanf(linha, "%lf %lf", min, max) != 2) {
+        return -1;
+    }
+    return 1;
+}
 
-    printf("\n=== ALIMENTOS POR ENERGIA (Decrescente): %s ===\n", categoria->nome);
-    printf("  Num | %-50s | Energia | Proteina\n", "Descricao");
-    printf("  %s\n", "----------------------------------------------------------------------");
-    percorrer_decrescente(categoria->arvore_energia);
-    printf("\n");
+/* Le a categoria de uma consulta por indice e escolhe a arvore: a do
+ * indice na categoria ou, com o nome vazio, a do indice global (uma so
+ * arvore para todas). Retorna false se a entrada falhar ou a categoria nao
+ * existir; a arvore pode ser NULL se a categoria estiver vazia. */
+static bool escolher_arvore(BaseDados* base, int indice, int indice_global,
+                            NoCategoria** categoria, NoArvore** arvore, const char** titulo) {
+    if (!ler_categoria_opcional(base, categoria, titulo)) {
+        return false;
+    }
+    *arvore = *categoria != NULL ? (*categoria)->indices[indice] : base->indices.globais[indice_global];
+    return true;
 }
 
-/* Executa a opcao 4: Listar alimentos por proteina (decrescente) */
-void opcao_listar_por_proteina(NoCategoria* lista) {
-    char nome_categoria[MAX_CATEGORIA];
+/* Lista os alimentos com chave em [min, max] de uma consulta por indice.
+ * Na categoria, percorre a arvore dela (a listagem decrescente e sempre a
+ * arvore inteira); sem categoria, busca a faixa no indice global com
+ * consultar_indice_global, em O(log n + k). */
+static void listar_por_indice(BaseDados* base, const NoCategoria* categoria, NoArvore* arvore,
+                              int indice_global, double min, double max, bool decrescente) {
+    if (categoria != NULL) {
+        if (decrescente) {
+            percorrer_decrescente(arvore);
+        } else {
+            percorrer_intervalo(arvore, min, max);
+        }
+        return;
+    }
 
-    printf("\nDigite o nome da categoria: ");
-    if (fgets(nome_categoria, MAX_CATEGORIA, stdin) == NULL) {
-        printf("Erro ao ler entrada.\n");
+    size_t limite = contar_intervalo_arvore(arvore, min, max);
+    NoAlimento** alimentos = (NoAlimento**)malloc((limite > 0 ? limite : 1) * sizeof(NoAlimento*));
+    if (alimentos == NULL) {
+        printf("Erro ao alocar memoria para a consulta.\n");
         return;
     }
 
-    size_t len = strlen(nome_categoria);
-    if (len > 0 && nome_categoria[len - 1] == '\n') {
-        nome_categoria[len - 1] = '\0';
+    size_t total = consultar_indice_global(&base->indices, indice_global, min, max, NULL,
+                                           decrescente, alimentos, limite);
+    for (size_t i = 0; i < total; i++) {
+        imprimir_alimento_listagem(alimentos[i]);
     }
+    free(alimentos);
+}
 
-    NoCategoria* categoria = buscar_categoria(lista, nome_categoria);
-    if (categoria == NULL) {
-        printf("Categoria nao encontrada.\n");
+/* Executa a opcao 3: Listar alimentos por energia (decrescente), de uma
+ * categoria ou de todas (nome vazio, pelo indice global) */
+void opcao_listar_por_energia(BaseDados* base) {
+    NoCategoria* categoria;
+    NoArvore* arvore;
+    const char* titulo;
+    if (!escolher_arvore(base, INDICE_ENERGIA, INDICE_ENERGIA_GLOBAL, &categoria, &arvore, &titulo)) {
         return;
     }
 
-    if (categoria->arvore_proteina == NULL) {
+    if (arvore == NULL) {
         printf("Nenhum alimento nesta categoria.\n");
         return;
     }
 
-    printf("\n=== ALIMENTOS POR PROTEINA (Decrescente): %s ===\n", categoria->nome);
+    printf("\n=== ALIMENTOS POR ENERGIA (Decrescente): %s ===\n", titulo);
     printf("  Num | %-50s | Energia | Proteina\n", "Descricao");
     printf("  %s\n", "----------------------------------------------------------------------");
-    percorrer_decrescente(categoria->arvore_proteina);
+    listar_por_indice(base, categoria, arvore, INDICE_ENERGIA_GLOBAL, -HUGE_VAL, HUGE_VAL, true);
     printf("\n");
 }
 
-/* Executa a opcao 5: Listar alimentos por intervalo de energia */
-void opcao_intervalo_energia(NoCategoria* lista) {
-    char nome_categoria[MAX_CATEGORIA];
-    double min = 0.0;
-    double max = 0.0;
-
-    printf("\nDigite o nome da categoria: ");
-    if (fgets(nome_categoria, MAX_CATEGORIA, stdin) == NULL) {
-        printf("Erro ao ler entrada.\n");
+/* Executa a opcao 4: Listar alimentos por proteina (decrescente), de uma
+ * categoria ou de todas (nome vazio, pelo indice global) */
+void opcao_listar_por_proteina(BaseDados* base) {
+    NoCategoria* categoria;
+    NoArvore* arvore;
+    const char* titulo;
+    if (!escolher_arvore(base, INDICE_PROTEINA, INDICE_PROTEINA_GLOBAL, &categoria, &arvore, &titulo)) {
         return;
     }
 
-    size_t len = strlen(nome_categoria);
-    if (len > 0 && nome_categoria[len - 1] == '\n') {
-        nome_categoria[len - 1] = '\0';
+    if (arvore == NULL) {
+        printf("Nenhum alimento nesta categoria.\n");
+        return;
     }
 
-    NoCategoria* categoria = buscar_categoria(lista, nome_categoria);
-    if (categoria == NULL) {
-        printf("Categoria nao encontrada.\n");
+    printf("\n=== ALIMENTOS POR PROTEINA (Decrescente): %s ===\n", titulo);
+    printf("  Num | %-50s | Energia | Proteina\n", "Descricao");
+    printf("  %s\n", "----------------------------------------------------------------------");
+    listar_por_indice(base, categoria, arvore, INDICE_PROTEINA_GLOBAL, -HUGE_VAL, HUGE_VAL, true);
+    printf("\n");
+}
+
+/* Executa a opcao 5: Listar alimentos por intervalo de energia, de uma
+ * categoria ou de todas (nome vazio): uma descida ate o minimo e a
+ * varredura da faixa, O(log n + k) */
+void opcao_intervalo_energia(BaseDados* base) {
+    NoCategoria* categoria;
+    NoArvore* arvore;
+    const char* titulo;
+    double min = 0.0;
+    double max = 0.0;
+
+    if (!escolher_arvore(base, INDICE_ENERGIA, INDICE_ENERGIA_GLOBAL, &categoria, &arvore, &titulo)) {
         return;
     }
 
     printf("Digite o valor minimo de energia (kcal): ");
     if (scanf("%lf", &min) != 1) {
         printf("Valor invalido.\n");
-        while (getchar() != '\n');
+        descartar_linha();
         return;
     }
 
     printf("Digite o valor maximo de energia (kcal): ");
     if (scanf("%lf", &max) != 1) {
         printf("Valor invalido.\n");
-        while (getchar() != '\n');
+        descartar_linha();
         return;
     }
-    while (getchar() != '\n');
+    descartar_linha();
 
-    if (categoria->arvore_energia == NULL) {
+    if (arvore == NULL) {
         printf("Nenhum alimento nesta categoria.\n");
         return;
     }
 
-    printf("\n=== ALIMENTOS COM ENERGIA ENTRE %.1f e %.1f kcal: %s ===\n", min, max, categoria->nome);
+    printf("\n=== ALIMENTOS COM ENERGIA ENTRE %.1f e %.1f kcal: %s ===\n", min, max, titulo);
     printf("  Num | %-50s | Energia | Proteina\n", "Descricao");
     printf("  %s\n", "----------------------------------------------------------------------");
-    percorrer_intervalo(categoria->arvore_energia, min, max);
+    listar_por_indice(base, categoria, arvore, INDICE_ENERGIA_GLOBAL, min, max, false);
     printf("\n");
 }
 
-/* Executa a opcao 6: Listar alimentos por intervalo de proteina */
-void opcao_intervalo_proteina(NoCategoria* lista) {
-    char nome_categoria[MAX_CATEGORIA];
+/* Executa a opcao 6: Listar alimentos por intervalo de proteina, de uma
+ * categoria ou de todas (nome vazio), em O(log n + k) */
+void opcao_intervalo_proteina(BaseDados* base) {
+    NoCategoria* categoria;
+    NoArvore* arvore;
+    const char* titulo;
     double min = 0.0;
     double max = 0.0;
 
-    printf("\nDigite o nome da categoria: ");
-    if (fgets(nome_categoria, MAX_CATEGORIA, stdin) == NULL) {
-        printf("Erro ao ler entrada.\n");
-        return;
-    }
-
-    size_t len = strlen(nome_categoria);
-    if (len > 0 && nome_categoria[len - 1] == '\n') {
-        nome_categoria[len - 1] = '\0';
-    }
-
-    NoCategoria* categoria = buscar_categoria(lista, nome_categoria);
-    if (categoria == NULL) {
-        printf("Categoria nao encontrada.\n");
+    if (!escolher_arvore(base, INDICE_PROTEINA, INDICE_PROTEINA_GLOBAL, &categoria, &arvore, &titulo)) {
         return;
     }
 
     printf("Digite o valor minimo de proteina (g): ");
     if (scanf("%lf", &min) != 1) {
         printf("Valor invalido.\n");
-        while (getchar() != '\n');
+        descartar_linha();
         return;
     }
 
     printf("Digite o valor maximo de proteina (g): ");
     if (scanf("%lf", &max) != 1) {
         printf("Valor invalido.\n");
-        while (getchar() != '\n');
+        descartar_linha();
         return;
     }
-    while (getchar() != '\n');
+    descartar_linha();
 
-    if (categoria->arvore_proteina == NULL) {
+    if (arvore == NULL) {
         printf("Nenhum alimento nesta categoria.\n");
         return;
     }
 
-    printf("\n=== ALIMENTOS COM PROTEINA ENTRE %.1f e %.1f g: %s ===\n", min, max, categoria->nome);
+    printf("\n=== ALIMENTOS COM PROTEINA ENTRE %.1f e %.1f g: %s ===\n", min, max, titulo);
     printf("  Num | %-50s | Energia | Proteina\n", "Descricao");
     printf("  %s\n", "----------------------------------------------------------------------");
-    percorrer_intervalo(categoria->arvore_proteina, min, max);
+    listar_por_indice(base, categoria, arvore, INDICE_PROTEINA_GLOBAL, min, max, false);
     printf("\n");
 }
 
 /* Executa a opcao 7: Remover uma categoria */
-NoCategoria* opcao_remover_categoria(NoCategoria* lista, bool* modificado) {
+void opcao_remover_categoria(BaseDados* base, bool* modificado) {
     char nome_categoria[MAX_CATEGORIA];
 
     printf("\nDigite o nome da categoria a remover: ");
     if (fgets(nome_categoria, MAX_CATEGORIA, stdin) == NULL) {
         printf("Erro ao ler entrada.\n");
-        return lista;
+        return;
     }
 
     size_t len = strlen(nome_categoria);
@@ -237,43 +312,410 @@ NoCategoria* opcao_remover_categoria(NoCategoria* lista, bool* modificado) {
         nome_categoria[len - 1] = '\0';
     }
 
-    NoCategoria* nova_lista = remover_categoria(lista, nome_categoria);
-    if (nova_lista != lista || buscar_categoria(lista, nome_categoria) == NULL) {
+    if (remover_categoria_da_base(base, nome_categoria)) {
         *modificado = true;
     }
-    return nova_lista;
 }
 
-/* Executa a opcao 8: Remover um alimento */
-void opcao_remover_alimento(NoCategoria* lista, bool* modificado) {
-    char nome_categoria[MAX_CATEGORIA];
+/* Executa a opcao 8: Remover um alimento pelo numero (sem pedir a categoria) */
+void opcao_remover_alimento(BaseDados* base, bool* modificado) {
     int numero_alimento = 0;
 
-    printf("\nDigite o nome da categoria do alimento: ");
-    if (fgets(nome_categoria, MAX_CATEGORIA, stdin) == NULL) {
-        printf("Erro ao ler entrada.\n");
+    printf("\nDigite o numero do alimento a remover: ");
+    if (scanf("%d", &numero_alimento) != 1) {
+        printf("Numero invalido.\n");
+        descartar_linha();
         return;
     }
+    descartar_linha();
 
-    size_t len = strlen(nome_categoria);
-    if (len > 0 && nome_categoria[len - 1] == '\n') {
-        nome_categoria[len - 1] = '\0';
+    if (!remover_alimento_da_base(base, numero_alimento)) {
+        printf("Alimento nao encontrado.\n");
+        return;
+    }
+    printf("Alimento removido com sucesso.\n");
+    *modificado = true;
+}
+
+/* Le uma faixa opcional para cada nutriente; retorna quantos filtros foram
+ * gravados em filtros (espaco para TOTAL_NUTRIENTES) ou -1 se a entrada
+ * for invalida */
+static int ler_filtros_nutrientes(FiltroIntervalo* filtros) {
+    static const struct {
+        ColunaNutriente coluna;
+        const char* nome;
+        const char* unidade;
+    } nutrientes[] = {
+        {COLUNA_UMIDADE, "umidade", "%"},
+        {COLUNA_ENERGIA, "energia", "kcal"},
+        {COLUNA_PROTEINA, "proteina", "g"},
+        {COLUNA_CARBOIDRATO, "carboidrato", "g"}
+    };
+    int total_filtros = 0;
+
+    printf("\n");
+    for (size_t i = 0; i < sizeof(nutrientes) / sizeof(nutrientes[0]); i++) {
+        double min = 0.0;
+        double max = 0.0;
+        int lida = ler_faixa(nutrientes[i].nome, nutrientes[i].unidade, &min, &max);
+        if (lida < 0) {
+            printf("Valor invalido.\n");
+            return -1;
+        }
+        if (lida > 0) {
+            filtros[total_filtros].coluna = nutrientes[i].coluna;
+            filtros[total_filtros].min = min;
+            filtros[total_filtros].max = max;
+            total_filtros++;
+        }
+    }
+
+    if (total_filtros == 0) {
+        printf("Nenhuma faixa informada.\n");
     }
+    return total_filtros;
+}
+
+/* Imprime as linhas marcadas na selecao, em ordem da tabela */
+static void imprimir_selecao(const TabelaAlimentos* tabela, const uint64_t* selecao) {
+    printf("  Num | %-50s | Energia | Proteina | Carboidrato | Umidade | Categoria\n", "Descricao");
+    printf("  %s\n", "----------------------------------------------------------------------");
+    for (size_t linha = 0; linha < tabela->total; linha++) {
+        if (!linha_marcada(selecao, linha)) {
+            continue;
+        }
+        const NoAlimento* alimento = tabela->alimento[linha];
+        printf("  %3d | %-50s | %4d kcal | %6.1f g | %9.1f g | %5.1f %% | %s\n",
+               tabela->numero[linha],
+               alimento->descricao,
+               tabela->energia_kcal[linha],
+               tabela->proteina[linha],
+               tabela->carboidrato[linha],
+               tabela->umidade[linha],
+               alimento->categoria->nome);
+    }
+}
 
-    NoCategoria* categoria = buscar_categoria(lista, nome_categoria);
-    if (categoria == NULL) {
-        printf("Categoria nao encontrada.\n");
+/* Executa a opcao 10: Filtrar alimentos de todas as categorias por faixas de
+ * qualquer nutriente. Cada faixa e avaliada sobre a coluna inteira da tabela
+ * (nucleos vetorizados) e as faixas sao combinadas com E. */
+void opcao_filtrar_nutrientes(BaseDados* base) {
+    FiltroIntervalo filtros[TOTAL_NUTRIENTES];
+    int total_filtros = ler_filtros_nutrientes(filtros);
+    if (total_filtros <= 0) {
         return;
     }
 
-    printf("Digite o numero do alimento a remover: ");
-    if (scanf("%d", &numero_alimento) != 1) {
+    const TabelaAlimentos* tabela = &base->tabela;
+    uint64_t* selecao = filtrar_tabela(tabela, filtros, (size_t)total_filtros);
+    if (selecao == NULL) {
+        return;
+    }
+
+    size_t encontrados = contar_selecao(selecao, palavras_selecao(tabela->total));
+    printf("\n=== FILTRO POR NUTRIENTES (%s): %lu alimento(s) ===\n",
+           nivel_simd_filtro(), (unsigned long)encontrados);
+    if (encontrados > 0) {
+        imprimir_selecao(tabela, selecao);
+    }
+    printf("\n");
+    free(selecao);
+}
+
+/* Imprime as estatisticas de cada nutriente de um resumo */
+static void imprimir_resumo(const char* titulo, const ResumoCategoria* resumo) {
+    static const char* const nomes[TOTAL_NUTRIENTES] = {
+        "Umidade (%)", "Energia (kcal)", "Proteina (g)", "Carboidrato (g)"
+    };
+
+    printf("\n%s (%lu alimento(s))\n", titulo, (unsigned long)resumo->quantidade);
+    if (resumo->quantidade == 0) {
+        return;
+    }
+    printf("  %-15s | %10s | %8s | %8s | %8s | %8s\n",
+           "Nutriente", "Soma", "Media", "Minimo", "Maximo", "Desvio");
+    for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+        const EstatisticaNutriente* e = &resumo->nutrientes[c];
+        printf("  %-15s | %10.1f | %8.2f | %8.1f | %8.1f | %8.2f\n",
+               nomes[c], e->soma, e->media, e->minimo, e->maximo, sqrt(e->variancia));
+    }
+}
+
+/* Executa a opcao 11: Estatisticas (soma, media, minimo, maximo e desvio
+ * padrao) de todos os nutrientes, agrupadas por categoria, e o total geral.
+ * Le as estatisticas mantidas em cada categoria, sem varrer os alimentos. */
+void opcao_estatisticas_categorias(BaseDados* base) {
+    ResumoCategoria geral;
+    memset(&geral, 0, sizeof(geral));
+
+    printf("\n=== ESTATISTICAS POR CATEGORIA ===\n");
+    for (NoCategoria* atual = base->lista_categorias; atual != NULL; atual = atual->proximo) {
+        ResumoCategoria resumo;
+        ler_estatisticas_categoria(atual, &resumo);
+        imprimir_resumo(atual->nome, &resumo);
+        combinar_resumos(&geral, &resumo);
+    }
+    imprimir_resumo("Todas as categorias", &geral);
+    printf("\n");
+}
+
+/* Executa a opcao 12: Os N alimentos de maior valor de uma metrica (nutriente
+ * ou razao) em uma categoria, ou em todas com o nome vazio. A selecao usa um
+ * heap limitado a N sobre a particao da tabela, sem ordenar a categoria. */
+void opcao_melhores_categoria(BaseDados* base) {
+    static const struct {
+        MetricaLinha metrica;
+        const char* nome;
+        const char* unidade;
+    } metricas[] = {
+        {metrica_umidade, "Umidade", "%"},
+        {metrica_energia, "Energia", "kcal"},
+        {metrica_proteina, "Proteina", "g"},
+        {metrica_carboidrato, "Carboidrato", "g"},
+        {metrica_energia_proteina, "Energia/Proteina", "kcal/g"},
+        {metrica_energia_carboidrato, "Energia/Carboidrato", "kcal/g"}
+    };
+    const int total_metricas = (int)(sizeof(metricas) / sizeof(metricas[0]));
+    NoCategoria* categoria;
+    const char* titulo;
+    int escolha = 0;
+    int n = 0;
+
+    if (!ler_categoria_opcional(base, &categoria, &titulo)) {
+        return;
+    }
+
+    const TabelaAlimentos* tabela = &base->tabela;
+    size_t inicio = 0;
+    size_t fim = tabela->total;
+    if (categoria != NULL) {
+        const ParticaoTabela* particao = particao_categoria(tabela, categoria);
+        inicio = particao->inicio;
+        fim = particao->fim;
+    }
+
+    for (int i = 0; i < total_metricas; i++) {
+        printf("  %d. %s\n", i + 1, metricas[i].nome);
+    }
+    printf("Escolha a metrica: ");
+    if (scanf("%d", &escolha) != 1 || escolha < 1 || escolha > total_metricas) {
+        printf("Metrica invalida.\n");
+        descartar_linha();
+        return;
+    }
+
+    printf("Digite a quantidade de alimentos (N): ");
+    if (scanf("%d", &n) != 1 || n <= 0) {
+        printf("Quantidade invalida.\n");
+        descartar_linha();
+        return;
+    }
+    descartar_linha();
+
+    size_t limite = (size_t)n < fim - inicio ? (size_t)n : fim - inicio;
+    size_t* linhas = (size_t*)malloc((limite > 0 ? limite : 1) * sizeof(size_t));
+    if (linhas == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para a selecao\n");
+        return;
+    }
+
+    MetricaLinha metrica = metricas[escolha - 1].metrica;
+    size_t total = selecionar_melhores(tabela, inicio, fim, metrica, limite, linhas);
+    if (total == 0) {
+        printf("Nenhum alimento encontrado.\n");
+        free(linhas);
+        return;
+    }
+
+    printf("\n=== TOP %d POR %s: %s ===\n", n, metricas[escolha - 1].nome, titulo);
+    printf("  Pos |  Num | %-50s | Valor\n", "Descricao");
+    printf("  %s\n", "----------------------------------------------------------------------");
+    for (size_t i = 0; i < total; i++) {
+        size_t linha = linhas[i];
+        printf("  %3lu | %4d | %-50s | %.2f %s\n",
+               (unsigned long)(i + 1),
+               tabela->numero[linha],
+               tabela->alimento[linha]->descricao,
+               metrica(tabela, linha),
+               metricas[escolha - 1].unidade);
+    }
+    printf("\n");
+    free(linhas);
+}
+
+/* Executa a opcao 13: Contagem de alimentos em uma faixa e percentis de
+ * qualquer indice por categoria (nutrientes e razoes), em uma categoria ou
+ * em todas (nome vazio, declarando o indice global da chave se faltar).
+ * Tudo sai dos tamanhos das subarvores de indice, sem listar nem ordenar
+ * os alimentos. */
+void opcao_contagens_percentis(BaseDados* base) {
+    static const double percentis[] = {10.0, 25.0, 50.0, 75.0, 90.0};
+    NoCategoria* categoria;
+    const char* titulo;
+    int escolha = 0;
+    double min = 0.0;
+    double max = 0.0;
+
+    if (!ler_categoria_opcional(base, &categoria, &titulo)) {
+        return;
+    }
+
+    const RegistroIndices* indices = &base->indices;
+    for (size_t i = 0; i < indices->total; i++) {
+        if (indices->definicoes[i].escopo == ESCOPO_CATEGORIA) {
+            printf("  %lu. %s\n", (unsigned long)(i + 1), indices->definicoes[i].nome);
+        }
+    }
+    printf("Escolha o indice: ");
+    if (scanf("%d", &escolha) != 1 || escolha < 1 || (size_t)escolha > indices->total ||
+        indices->definicoes[escolha - 1].escopo != ESCOPO_CATEGORIA) {
+        printf("Indice invalido.\n");
+        descartar_linha();
+        return;
+    }
+    descartar_linha();
+
+    int indice = escolha - 1;
+    const char* nome = indices->definicoes[indice].nome;
+    const char* unidade = indices->definicoes[indice].unidade;
+    int faixa = ler_faixa(nome, unidade, &min, &max);
+    if (faixa < 0) {
+        printf("Valor invalido.\n");
+        return;
+    }
+
+    /* Sem categoria, a chave ganha um indice global na primeira consulta:
+     * dai em diante contagens e percentis saem de uma so arvore, em vez de
+     * combinar as arvores de todas as categorias (ver ordem.h) */
+    MetricaLinha chave = indices->definicoes[indice].chave;
+    if (categoria == NULL && indice_global_da_chave(indices, chave) < 0) {
+        char nome_global[64];
+        snprintf(nome_global, sizeof(nome_global), "%s (global)", nome);
+        declarar_indice(base, nome_global, unidade, chave, ESCOPO_GLOBAL);
+    }
+
+    size_t total = categoria != NULL ? total_categoria(categoria, indice)
+                                     : total_global(base, indice);
+    printf("\n=== %s (%s): %s ===\n", nome, unidade, titulo);
+    printf("Alimentos: %lu\n", (unsigned long)total);
+    if (total == 0) {
+        printf("\n");
+        return;
+    }
+
+    if (faixa > 0) {
+        size_t na_faixa = categoria != NULL
+            ? contar_intervalo_categoria(categoria, indice, min, max)
+            : contar_intervalo_global(base, indice, min, max);
+        printf("Na faixa [%.1f, %.1f]: %lu (%.1f%%)\n", min, max, (unsigned long)na_faixa,
+               100.0 * (double)na_faixa / (double)total);
+    }
+
+    for (size_t i = 0; i < sizeof(percentis) / sizeof(percentis[0]); i++) {
+        double valor = 0.0;
+        bool achou = categoria != NULL
+            ? percentil_categoria(categoria, indice, percentis[i], &valor)
+            : percentil_global(base, indice, percentis[i], &valor);
+        if (achou) {
+            printf("  P%-3.0f %s %8.2f %s\n", percentis[i], percentis[i] == 50.0 ? "(mediana)" : "         ",
+                   valor, unidade);
+        }
+    }
+    printf("\n");
+}
+
+/* Executa a opcao 14: Mesma consulta da opcao 10 (uma faixa por nutriente,
+ * combinadas com E), respondida pela arvore k-d dos nutrientes: so as
+ * regioes que cortam a caixa sao visitadas, sem varrer as colunas. */
+void opcao_caixa_nutrientes(BaseDados* base) {
+    FiltroIntervalo filtros[TOTAL_NUTRIENTES];
+    int total_filtros = ler_filtros_nutrientes(filtros);
+    if (total_filtros <= 0) {
+        return;
+    }
+
+    const TabelaAlimentos* tabela = &base->tabela;
+    size_t palavras = palavras_selecao(tabela->total);
+    uint64_t* selecao = (uint64_t*)malloc((palavras > 0 ? palavras : 1) * sizeof(uint64_t));
+    if (selecao == NULL) {
+        printf("Erro ao alocar memoria para a consulta.\n");
+        return;
+    }
+
+    size_t encontrados = consultar_caixa_kd(&base->nutrientes, tabela, filtros, (size_t)total_filtros, selecao);
+    printf("\n=== CAIXA DE NUTRIENTES (arvore k-d): %lu alimento(s) ===\n", (unsigned long)encontrados);
+    if (encontrados > 0) {
+        imprimir_selecao(tabela, selecao);
+    }
+    printf("\n");
+    free(selecao);
+}
+
+/* Executa a opcao 15: Os k alimentos mais parecidos com um alimento dado
+ * (distancia entre os nutrientes normalizados), em uma categoria ou em
+ * todas (nome vazio) */
+void opcao_similares(BaseDados* base) {
+    NoCategoria* categoria;
+    const char* titulo;
+    int numero = 0;
+    int k = 0;
+
+    printf("\nDigite o numero do alimento: ");
+    if (scanf("%d", &numero) != 1) {
         printf("Numero invalido.\n");
-        while (getchar() != '\n');
+        descartar_linha();
         return;
     }
-    while (getchar() != '\n');
+    descartar_linha();
 
-    remover_alimento_de_categoria(categoria, numero_alimento);
-    *modificado = true;
+    const EntradaNumero* entrada = buscar_indice_numero(&base->numeros, numero);
+    if (entrada == NULL) {
+        printf("Alimento nao encontrado.\n");
+        return;
+    }
+
+    if (!ler_categoria_opcional(base, &categoria, &titulo)) {
+        return;
+    }
+
+    printf("Digite a quantidade de alimentos (k): ");
+    if (scanf("%d", &k) != 1 || k <= 0) {
+        printf("Quantidade invalida.\n");
+        descartar_linha();
+        return;
+    }
+    descartar_linha();
+
+    const TabelaAlimentos* tabela = &base->tabela;
+    size_t limite = (size_t)k < tabela->presentes ? (size_t)k : tabela->presentes;
+    Vizinho* vizinhos = (Vizinho*)malloc((limite > 0 ? limite : 1) * sizeof(Vizinho));
+    if (vizinhos == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para a busca\n");
+        return;
+    }
+
+    size_t total = buscar_similares(base, numero, categoria, limite, vizinhos);
+    printf("\n=== SIMILARES A %d - %s: %s ===\n", numero, entrada->alimento->descricao, titulo);
+    if (total == 0) {
+        printf("Nenhum alimento encontrado.\n\n");
+        free(vizinhos);
+        return;
+    }
+
+    printf("  Pos |  Num | %-50s | Distancia | Energia | Proteina | Carboidrato | Umidade\n", "Descricao");
+    printf("  %s\n", "----------------------------------------------------------------------");
+    for (size_t i = 0; i < total; i++) {
+        size_t linha = vizinhos[i].linha;
+        printf("  %3lu | %4d | %-50s | %9.3f | %4d kcal | %6.1f g | %9.1f g | %5.1f %%\n",
+               (unsigned long)(i + 1),
+               tabela->numero[linha],
+               tabela->alimento[linha]->descricao,
+               vizinhos[i].distancia,
+               tabela->energia_kcal[linha],
+               tabela->proteina[linha],
+               tabela->carboidrato[linha],
+               tabela->umidade[linha]);
+    }
+    printf("\n");
+    free(vizinhos);
 }
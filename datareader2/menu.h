@@ -3,31 +3,52 @@
 
 #include "tipos.h"
 
+/* Opcao de saida do menu (tambem devolvida no fim da entrada) */
+#define OPCAO_SAIR 9
+
 /* Exibe o menu principal e retorna a opcao escolhida */
 int exibir_menu();
 
 /* Executa a opcao 1: Listar todas as categorias */
-void opcao_listar_categorias(NoCategoria* lista);
+void opcao_listar_categorias(BaseDados* base);
 
 /* Executa a opcao 2: Listar alimentos de uma categoria */
-void opcao_listar_alimentos(NoCategoria* lista);
+void opcao_listar_alimentos(BaseDados* base);
 
 /* Executa a opcao 3: Listar alimentos por energia (decrescente) */
-void opcao_listar_por_energia(NoCategoria* lista);
+void opcao_listar_por_energia(BaseDados* base);
 
 /* Executa a opcao 4: Listar alimentos por proteina (decrescente) */
-void opcao_listar_por_proteina(NoCategoria* lista);
+void opcao_listar_por_proteina(BaseDados* base);
 
 /* Executa a opcao 5: Listar alimentos por intervalo de energia */
-void opcao_intervalo_energia(NoCategoria* lista);
+void opcao_intervalo_energia(BaseDados* base);
 
 /* Executa a opcao 6: Listar alimentos por intervalo de proteina */
-void opcao_intervalo_proteina(NoCategoria* lista);
+void opcao_intervalo_proteina(BaseDados* base);
 
 /* Executa a opcao 7: Remover uma categoria */
-NoCategoria* opcao_remover_categoria(NoCategoria* lista, bool* modificado);
+void opcao_remover_categoria(BaseDados* base, bool* modificado);
+
+/* Executa a opcao 8: Remover um alimento pelo numero */
+void opcao_remover_alimento(BaseDados* base, bool* modificado);
+
+/* Executa a opcao 10: Filtrar alimentos de todas as categorias por faixas de nutrientes */
+void opcao_filtrar_nutrientes(BaseDados* base);
+
+/* Executa a opcao 11: Estatisticas de todos os nutrientes por categoria */
+void opcao_estatisticas_categorias(BaseDados* base);
+
+/* Executa a opcao 12: Os N melhores alimentos de uma categoria (ou de todas) por uma metrica */
+void opcao_melhores_categoria(BaseDados* base);
+
+/* Executa a opcao 13: Contagem em faixa e percentis de um nutriente ou razao indexado */
+void opcao_contagens_percentis(BaseDados* base);
+
+/* Executa a opcao 14: Filtrar alimentos por faixas de nutrientes pela arvore k-d */
+void opcao_caixa_nutrientes(BaseDados* base);
 
-/* Executa a opcao 8: Remover um alimento */
-void opcao_remover_alimento(NoCategoria* lista, bool* modificado);
+/* Executa a opcao 15: Os k alimentos mais parecidos com um alimento, pelos nutrientes */
+void opcao_similares(BaseDados* base);
 
 #endif
@@ -0,0 +1,197 @@
+#include "ordem.h"
+#include "arvore.h"
+#include "indices.h"
+
+/* Arvore do indice na categoria, ou NULL se o numero nao for de um indice
+ * por categoria (os globais nao tem arvore na categoria) */
+NoArvore* arvore_da_categoria(const NoCategoria* categoria, int indice) {
+    if (indice < 0 || indice >= MAX_INDICES) {
+        return NULL;
+    }
+    return categoria->indices[indice];
+}
+
+/* Posicao fracionaria do percentil p entre n valores ordenados (0 a n-1),
+ * separada em posto inteiro e fracao */
+static void posicao_percentil(size_t n, double p, size_t* posto, double* fracao) {
+    if (p < 0.0) {
+        p = 0.0;
+    } else if (p > 100.0) {
+        p = 100.0;
+    }
+    double posicao = p / 100.0 * (double)(n - 1);
+    *posto = (size_t)posicao;
+    if (*posto >= n - 1) {
+        *posto = n - 1;
+        *fracao = 0.0;
+    } else {
+        *fracao = posicao - (double)*posto;
+    }
+}
+
+/* Quantidade de alimentos da categoria no indice */
+size_t total_categoria(const NoCategoria* categoria, int indice) {
+    return tamanho_arvore(arvore_da_categoria(categoria, indice));
+}
+
+/* Alimentos da categoria com chave do indice em [min, max], em O(log n) */
+size_t contar_intervalo_categoria(const NoCategoria* categoria, int indice, double min, double max) {
+    return contar_intervalo_arvore(arvore_da_categoria(categoria, indice), min, max);
+}
+
+/* Posto do valor na categoria: alimentos com valor menor */
+size_t posto_categoria(const NoCategoria* categoria, int indice, double valor) {
+    return contar_menores_arvore(arvore_da_categoria(categoria, indice), valor);
+}
+
+/* k-esimo alimento da categoria em ordem crescente da chave, ou NULL */
+NoAlimento* selecionar_categoria(const NoCategoria* categoria, int indice, size_t k) {
+    NoArvore* no = selecionar_arvore(arvore_da_categoria(categoria, indice), k);
+    return no != NULL ? no->alimento : NULL;
+}
+
+/* Percentil p (0 a 100) da chave na categoria, interpolando linearmente
+ * entre os dois postos vizinhos (p = 50 e a mediana) */
+bool percentil_categoria(const NoCategoria* categoria, int indice, double p, double* valor) {
+    NoArvore* arvore = arvore_da_categoria(categoria, indice);
+    size_t n = tamanho_arvore(arvore);
+    if (n == 0) {
+        return false;
+    }
+
+    size_t posto;
+    double fracao;
+    posicao_percentil(n, p, &posto, &fracao);
+    *valor = selecionar_arvore(arvore, posto)->chave;
+    if (fracao > 0.0) {
+        *valor += fracao * (selecionar_arvore(arvore, posto + 1)->chave - *valor);
+    }
+    return true;
+}
+
+/* Indice global que responde pelo indice dado: ele mesmo, se for global,
+ * ou o global com a mesma chave; -1 se nao houver (combina as categorias) */
+static int indice_global(const RegistroIndices* indices, int indice) {
+    if (indice < 0 || (size_t)indice >= indices->total) {
+        return -1;
+    }
+    if (indices->definicoes[indice].escopo == ESCOPO_GLOBAL) {
+        return indice;
+    }
+    return indice_global_da_chave(indices, indices->definicoes[indice].chave);
+}
+
+/* Quantidade de alimentos de todas as categorias no indice */
+size_t total_global(const BaseDados* base, int indice) {
+    int global = indice_global(&base->indices, indice);
+    if (global >= 0) {
+        return tamanho_arvore(base->indices.globais[global]);
+    }
+
+    size_t total = 0;
+    for (const NoCategoria* lista = base->lista_categorias; lista != NULL; lista = lista->proximo) {
+        total += tamanho_arvore(arvore_da_categoria(lista, indice));
+    }
+    return total;
+}
+
+/* Alimentos de todas as categorias com chave do indice em [min, max] */
+size_t contar_intervalo_global(const BaseDados* base, int indice, double min, double max) {
+    int global = indice_global(&base->indices, indice);
+    if (global >= 0) {
+        return contar_intervalo_arvore(base->indices.globais[global], min, max);
+    }
+
+    size_t total = 0;
+    for (const NoCategoria* lista = base->lista_categorias; lista != NULL; lista = lista->proximo) {
+        total += contar_intervalo_arvore(arvore_da_categoria(lista, indice), min, max);
+    }
+    return total;
+}
+
+/* Posto global do valor: alimentos de todas as categorias com valor menor */
+size_t posto_global(const BaseDados* base, int indice, double valor) {
+    int global = indice_global(&base->indices, indice);
+    if (global >= 0) {
+        return contar_menores_arvore(base->indices.globais[global], valor);
+    }
+
+    size_t total = 0;
+    for (const NoCategoria* lista = base->lista_categorias; lista != NULL; lista = lista->proximo) {
+        total += contar_menores_arvore(arvore_da_categoria(lista, indice), valor);
+    }
+    return total;
+}
+
+/* Alimentos de todas as categorias com valor menor ou igual */
+static size_t contar_ate_global(const NoCategoria* lista, int indice, double valor) {
+    size_t total = 0;
+    for (; lista != NULL; lista = lista->proximo) {
+        total += contar_ate_arvore(arvore_da_categoria(lista, indice), valor);
+    }
+    return total;
+}
+
+/* k-esimo menor valor do indice entre todas as categorias (k a partir de 0).
+ * Com indice global e um k-esimo direto em O(log n). Sem ele, o resultado
+ * e o menor valor v com mais de k alimentos <= v; em cada arvore, uma
+ * busca binaria por posto acha o menor valor dela com essa propriedade, e
+ * o resultado e o menor entre as arvores. */
+bool selecionar_global(const BaseDados* base, int indice, size_t k, double* valor) {
+    int global = indice_global(&base->indices, indice);
+    if (global >= 0) {
+        NoArvore* no = selecionar_arvore(base->indices.globais[global], k);
+        if (no == NULL) {
+            return false;
+        }
+        *valor = no->chave;
+        return true;
+    }
+
+    const NoCategoria* lista = base->lista_categorias;
+    bool achou = false;
+    for (const NoCategoria* atual = lista; atual != NULL; atual = atual->proximo) {
+        NoArvore* arvore = arvore_da_categoria(atual, indice);
+        size_t baixo = 0;
+        size_t alto = tamanho_arvore(arvore);
+        while (baixo < alto) {
+            size_t meio = baixo + (alto - baixo) / 2;
+            if (contar_ate_global(lista, indice, selecionar_arvore(arvore, meio)->chave) > k) {
+                alto = meio;
+            } else {
+                baixo = meio + 1;
+            }
+        }
+        if (baixo < tamanho_arvore(arvore)) {
+            double candidato = selecionar_arvore(arvore, baixo)->chave;
+            if (!achou || candidato < *valor) {
+                *valor = candidato;
+                achou = true;
+            }
+        }
+    }
+    return achou;
+}
+
+/* Percentil p (0 a 100) da chave entre todas as categorias, interpolado */
+bool percentil_global(const BaseDados* base, int indice, double p, double* valor) {
+    size_t n = total_global(base, indice);
+    if (n == 0) {
+        return false;
+    }
+
+    size_t posto;
+    double fracao;
+    posicao_percentil(n, p, &posto, &fracao);
+    if (!selecionar_global(base, indice, posto, valor)) {
+        return false;
+    }
+    if (fracao > 0.0) {
+        double seguinte;
+        if (!selecionar_global(base, indice, posto + 1, &seguinte)) {
+            return false;
+        }
+        *valor += fracao * (seguinte - *valor);
+    }
+    return true;
+}
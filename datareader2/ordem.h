@@ -0,0 +1,35 @@
+#ifndef ORDEM_H
+#define ORDEM_H
+
+#include "tipos.h"
+
+/* Estatisticas de ordem sobre os indices (ver indices.h; qualquer
+ * nutriente ou razao): contagem em faixa, posto, k-esimo e percentil, por
+ * categoria em O(log n) e globais. */
+
+/* Arvore do indice na categoria, ou NULL se o numero nao for de um indice
+ * por categoria */
+NoArvore* arvore_da_categoria(const NoCategoria* categoria, int indice);
+
+/* Por categoria: quantidade de alimentos, alimentos com valor em [min, max],
+ * posto (alimentos com valor menor), k-esimo menor (k a partir de 0; NULL
+ * se nao existir) e percentil p (0 a 100, interpolado; false se vazia) */
+size_t total_categoria(const NoCategoria* categoria, int indice);
+size_t contar_intervalo_categoria(const NoCategoria* categoria, int indice, double min, double max);
+size_t posto_categoria(const NoCategoria* categoria, int indice, double valor);
+NoAlimento* selecionar_categoria(const NoCategoria* categoria, int indice, size_t k);
+bool percentil_categoria(const NoCategoria* categoria, int indice, double p, double* valor);
+
+/* As mesmas consultas sobre todas as categorias da base, devolvendo o
+ * valor no k-esimo. Se houver um indice global com a mesma chave (ou o
+ * numero ja for de um global), tudo sai da arvore dele em O(log n). Senao
+ * as arvores das categorias sao combinadas: contagem e posto somam as
+ * categorias (O(C log n)); o k-esimo busca em cada arvore o menor valor
+ * cujo posto global passa de k (O(C^2 log^2 n)). */
+size_t total_global(const BaseDados* base, int indice);
+size_t contar_intervalo_global(const BaseDados* base, int indice, double min, double max);
+size_t posto_global(const BaseDados* base, int indice, double valor);
+bool selecionar_global(const BaseDados* base, int indice, size_t k, double* valor);
+bool percentil_global(const BaseDados* base, int indice, double p, double* valor);
+
+#endif
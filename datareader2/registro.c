@@ -0,0 +1,117 @@
+#include "registro.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CAPACIDADE_MINIMA_REGISTRO 32
+
+/* Hash FNV-1a do nome de uma categoria */
+static size_t hash_nome(const char* nome) {
+    size_t hash = (size_t)2166136261u;
+    for (const unsigned char* c = (const unsigned char*)nome; *c != '\0'; c++) {
+        hash = (hash ^ *c) * (size_t)16777619u;
+    }
+    return hash;
+}
+
+/* Posicao da tabela onde o nome esta ou deveria estar (sondagem linear) */
+static size_t localizar(const RegistroCategorias* registro, const char* nome) {
+    size_t mascara = registro->capacidade - 1;
+    size_t posicao = hash_nome(nome) & mascara;
+    while (registro->tabela[posicao] != NULL && strcmp(registro->tabela[posicao]->nome, nome) != 0) {
+        posicao = (posicao + 1) & mascara;
+    }
+    return posicao;
+}
+
+/* Aloca uma tabela vazia com a capacidade indicada */
+static void alocar_tabela(RegistroCategorias* registro, size_t capacidade) {
+    registro->tabela = (NoCategoria**)calloc(capacidade, sizeof(NoCategoria*));
+    if (registro->tabela == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para o registro de categorias.\n");
+        exit(1);
+    }
+    registro->capacidade = capacidade;
+}
+
+/* Dobra a tabela e reinsere as categorias */
+static void crescer_tabela(RegistroCategorias* registro) {
+    NoCategoria** antiga = registro->tabela;
+    size_t capacidade_antiga = registro->capacidade;
+
+    alocar_tabela(registro, capacidade_antiga * 2);
+    for (size_t i = 0; i < capacidade_antiga; i++) {
+        if (antiga[i] != NULL) {
+            registro->tabela[localizar(registro, antiga[i]->nome)] = antiga[i];
+        }
+    }
+    free(antiga);
+}
+
+/* Prepara um registro vazio com espaco para a quantidade esperada de categorias */
+void inicializar_registro(RegistroCategorias* registro, size_t total_esperado) {
+    memset(registro, 0, sizeof(RegistroCategorias));
+
+    /* Mantem a ocupacao abaixo de 50% */
+    size_t capacidade = CAPACIDADE_MINIMA_REGISTRO;
+    while (capacidade < total_esperado * 2) {
+        capacidade *= 2;
+    }
+    alocar_tabela(registro, capacidade);
+}
+
+/* Registra uma categoria pelo nome */
+void registrar_categoria(RegistroCategorias* registro, NoCategoria* categoria) {
+    if ((registro->total + 1) * 2 > registro->capacidade) {
+        crescer_tabela(registro);
+    }
+
+    size_t posicao = localizar(registro, categoria->nome);
+    if (registro->tabela[posicao] == NULL) {
+        registro->total++;
+    }
+    registro->tabela[posicao] = categoria;
+}
+
+/* Busca uma categoria pelo nome em O(1); retorna NULL se nao existir */
+NoCategoria* buscar_categoria_registro(const RegistroCategorias* registro, const char* nome) {
+    if (registro->tabela == NULL) {
+        return NULL;
+    }
+    return registro->tabela[localizar(registro, nome)];
+}
+
+/* Retira uma categoria do registro.
+ * As entradas seguintes da mesma sequencia de sondagem sao puxadas para tras,
+ * para que a tabela continue sem marcas de remocao. */
+void desregistrar_categoria(RegistroCategorias* registro, NoCategoria* categoria) {
+    if (registro->tabela == NULL) {
+        return;
+    }
+
+    size_t mascara = registro->capacidade - 1;
+    size_t vazia = localizar(registro, categoria->nome);
+    if (registro->tabela[vazia] != categoria) {
+        return;
+    }
+    registro->tabela[vazia] = NULL;
+    registro->total--;
+
+    size_t atual = (vazia + 1) & mascara;
+    while (registro->tabela[atual] != NULL) {
+        size_t ideal = hash_nome(registro->tabela[atual]->nome) & mascara;
+        /* A entrada pode ocupar a posicao vazia se ela estiver entre a ideal e a atual */
+        if (((atual - ideal) & mascara) >= ((atual - vazia) & mascara)) {
+            registro->tabela[vazia] = registro->tabela[atual];
+            registro->tabela[atual] = NULL;
+            vazia = atual;
+        }
+        atual = (atual + 1) & mascara;
+    }
+}
+
+/* Libera a tabela do registro */
+void liberar_registro(RegistroCategorias* registro) {
+    free(registro->tabela);
+    memset(registro, 0, sizeof(RegistroCategorias));
+}
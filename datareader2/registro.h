@@ -0,0 +1,21 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include "tipos.h"
+
+/* Prepara um registro vazio com espaco para a quantidade esperada de categorias */
+void inicializar_registro(RegistroCategorias* registro, size_t total_esperado);
+
+/* Registra uma categoria pelo nome */
+void registrar_categoria(RegistroCategorias* registro, NoCategoria* categoria);
+
+/* Busca uma categoria pelo nome em O(1); retorna NULL se nao existir */
+NoCategoria* buscar_categoria_registro(const RegistroCategorias* registro, const char* nome);
+
+/* Retira uma categoria do registro */
+void desregistrar_categoria(RegistroCategorias* registro, NoCategoria* categoria);
+
+/* Libera a tabela do registro */
+void liberar_registro(RegistroCategorias* registro);
+
+#endif
@@ -0,0 +1,33 @@
+#include "simd.h"
+
+/* Melhor nivel suportado pelo processador, detectado uma vez. Fora de x86
+ * (ou sem GCC/Clang) o nivel e sempre o escalar. */
+NivelSimd nivel_simd(void) {
+    static bool detectado = false;
+    static NivelSimd nivel = NIVEL_ESCALAR;
+
+    if (!detectado) {
+#ifdef SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            nivel = NIVEL_AVX2;
+        } else if (__builtin_cpu_supports("sse2")) {
+            nivel = NIVEL_SSE2;
+        }
+#endif
+        detectado = true;
+    }
+    return nivel;
+}
+
+/* Nome do nivel: "AVX2", "SSE2" ou "escalar" */
+const char* nome_nivel_simd(NivelSimd nivel) {
+    switch (nivel) {
+        case NIVEL_AVX2:
+            return "AVX2";
+        case NIVEL_SSE2:
+            return "SSE2";
+        default:
+            return "escalar";
+    }
+}
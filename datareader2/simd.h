@@ -0,0 +1,29 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdbool.h>
+
+/* Deteccao do conjunto de instrucoes, compartilhada pelos nucleos
+ * vetorizados (filtro, agregacao, similares). Os nucleos usam atributos de
+ * alvo do GCC/Clang: o programa continua compilado para a arquitetura base
+ * e cada modulo escolhe o seu nucleo ao rodar. SIMD_X86 indica que os
+ * nucleos x86 podem ser compilados. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+/* Niveis em ordem crescente: um nivel inclui os anteriores */
+typedef enum {
+    NIVEL_ESCALAR,
+    NIVEL_SSE2,
+    NIVEL_AVX2
+} NivelSimd;
+
+/* Melhor nivel suportado pelo processador (detectado na primeira chamada) */
+NivelSimd nivel_simd(void);
+
+/* Nome do nivel: "AVX2", "SSE2" ou "escalar" */
+const char* nome_nivel_simd(NivelSimd nivel);
+
+#endif
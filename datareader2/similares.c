@@ -0,0 +1,406 @@
+#include "similares.h"
+#include "arvore_kd.h"
+#include "indice_numero.h"
+#include "simd.h"
+#include "tabela.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LINHAS_POR_BLOCO 4
+#define LINHAS_POR_LOTE 256
+
+/* Os k melhores ate agora, com o mais distante na raiz. Guarda o quadrado
+ * da distancia; a raiz so e tirada ao final. */
+typedef struct {
+    Vizinho* itens;
+    size_t tamanho;
+    size_t capacidade;
+} HeapVizinhos;
+
+/* Os nucleos nao mexem no heap: gravam em candidatos as linhas presentes
+ * de [inicio, fim) com distancia (ao quadrado) ate o limite e retornam
+ * quantas gravaram. Assim o nucleo AVX2 nunca chama codigo SSE com a
+ * metade alta dos registradores suja. */
+typedef size_t (*NucleoSimilares)(const TabelaAlimentos*, size_t, size_t, const double*, const double*,
+                                  double, Vizinho*);
+
+/* a e pior que b: mais distante, ou mesma distancia e linha posterior */
+static int pior(const Vizinho* a, const Vizinho* b) {
+    if (a->distancia != b->distancia) {
+        return a->distancia > b->distancia;
+    }
+    return a->linha > b->linha;
+}
+
+/* Desce o vizinho da posicao i; o pior do heap fica na raiz */
+static void descer(Vizinho* heap, size_t tamanho, size_t i) {
+    for (;;) {
+        size_t alvo = i;
+        size_t esquerda = 2 * i + 1;
+        size_t direita = esquerda + 1;
+        if (esquerda < tamanho && pior(&heap[esquerda], &heap[alvo])) {
+            alvo = esquerda;
+        }
+        if (direita < tamanho && pior(&heap[direita], &heap[alvo])) {
+            alvo = direita;
+        }
+        if (alvo == i) {
+            return;
+        }
+        Vizinho temp = heap[i];
+        heap[i] = heap[alvo];
+        heap[alvo] = temp;
+        i = alvo;
+    }
+}
+
+/* Sobe o vizinho da posicao i enquanto for pior que o pai */
+static void subir(Vizinho* heap, size_t i) {
+    while (i > 0) {
+        size_t pai = (i - 1) / 2;
+        if (!pior(&heap[i], &heap[pai])) {
+            return;
+        }
+        Vizinho temp = heap[i];
+        heap[i] = heap[pai];
+        heap[pai] = temp;
+        i = pai;
+    }
+}
+
+/* Maior distancia (ao quadrado) que ainda pode entrar no heap */
+static double limite_heap(const HeapVizinhos* heap) {
+    return heap->tamanho < heap->capacidade ? INFINITY : heap->itens[0].distancia;
+}
+
+/* Oferece uma linha ao heap: entra se ainda houver espaco ou se for melhor que a raiz */
+static void oferecer(HeapVizinhos* heap, size_t linha, double distancia) {
+    Vizinho candidato;
+    candidato.linha = linha;
+    candidato.distancia = distancia;
+    if (heap->tamanho < heap->capacidade) {
+        heap->itens[heap->tamanho] = candidato;
+        subir(heap->itens, heap->tamanho);
+        heap->tamanho++;
+    } else if (pior(&heap->itens[0], &candidato)) {
+        heap->itens[0] = candidato;
+        descer(heap->itens, heap->tamanho, 0);
+    }
+}
+
+/* Aloca um heap para ate k vizinhos */
+static void criar_heap(HeapVizinhos* heap, size_t k) {
+    heap->itens = (Vizinho*)malloc(k * sizeof(Vizinho));
+    if (heap->itens == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para a busca de similares\n");
+        exit(1);
+    }
+    heap->tamanho = 0;
+    heap->capacidade = k;
+}
+
+/* Esvazia o heap em saida, do mais proximo para o mais distante, tirando a
+ * raiz quadrada das distancias; libera o heap e retorna quantos gravou */
+static size_t esvaziar_heap(HeapVizinhos* heap, Vizinho* saida) {
+    size_t total = heap->tamanho;
+    while (heap->tamanho > 0) {
+        saida[heap->tamanho - 1].linha = heap->itens[0].linha;
+        saida[heap->tamanho - 1].distancia = sqrt(heap->itens[0].distancia);
+        heap->tamanho--;
+        heap->itens[0] = heap->itens[heap->tamanho];
+        descer(heap->itens, heap->tamanho, 0);
+    }
+    free(heap->itens);
+    heap->itens = NULL;
+    return total;
+}
+
+/* Quadrado da distancia normalizada de uma linha ate a consulta. Os termos
+ * sao somados na ordem das colunas, como no nucleo AVX2 e na arvore k-d,
+ * para que os tres caminhos deem exatamente o mesmo valor. */
+static double distancia_linha(const TabelaAlimentos* tabela, size_t linha,
+                              const double* consulta, const double* escala) {
+    double u = escala[COLUNA_UMIDADE] * (tabela->umidade[linha] - consulta[COLUNA_UMIDADE]);
+    double e = escala[COLUNA_ENERGIA] * ((double)tabela->energia_kcal[linha] - consulta[COLUNA_ENERGIA]);
+    double p = escala[COLUNA_PROTEINA] * (tabela->proteina[linha] - consulta[COLUNA_PROTEINA]);
+    double c = escala[COLUNA_CARBOIDRATO] * (tabela->carboidrato[linha] - consulta[COLUNA_CARBOIDRATO]);
+    return u * u + e * e + p * p + c * c;
+}
+
+/* Escalar: visita so as linhas presentes de [inicio, fim) */
+static size_t candidatos_escalar(const TabelaAlimentos* tabela, size_t inicio, size_t fim, const double* consulta,
+                                 const double* escala, double limite, Vizinho* candidatos) {
+    size_t total = 0;
+    size_t l;
+    for (l = proxima_linha(tabela, inicio, fim); l < fim; l = proxima_linha(tabela, l + 1, fim)) {
+        double distancia = distancia_linha(tabela, l, consulta, escala);
+        if (distancia <= limite) {
+            candidatos[total].linha = l;
+            candidatos[total].distancia = distancia;
+            total++;
+        }
+    }
+    return total;
+}
+
+#ifdef SIMD_X86
+/* AVX2: distancias de 4 linhas por vez, com a presenca e o limite virando
+ * uma mascara; so as linhas que passam saem do registrador. Blocos
+ * alinhados em 4 como em agregacao.c; cabeca e cauda ficam com o escalar,
+ * antes do laco vetorial. */
+__attribute__((target("avx2")))
+static size_t candidatos_avx2(const TabelaAlimentos* tabela, size_t inicio, size_t fim, const double* consulta,
+                              const double* escala, double limite, Vizinho* candidatos) {
+    size_t inicio_vetor = (inicio + LINHAS_POR_BLOCO - 1) / LINHAS_POR_BLOCO * LINHAS_POR_BLOCO;
+    if (inicio_vetor > fim) {
+        inicio_vetor = fim;
+    }
+    size_t fim_vetor = inicio_vetor + (fim - inicio_vetor) / LINHAS_POR_BLOCO * LINHAS_POR_BLOCO;
+    size_t total = candidatos_escalar(tabela, inicio, inicio_vetor, consulta, escala, limite, candidatos);
+    total += candidatos_escalar(tabela, fim_vetor, fim, consulta, escala, limite, candidatos + total);
+
+    const double* umidade = tabela->umidade;
+    const int* energia = tabela->energia_kcal;
+    const double* proteina = tabela->proteina;
+    const double* carboidrato = tabela->carboidrato;
+    const __m256d centro_u = _mm256_set1_pd(consulta[COLUNA_UMIDADE]);
+    const __m256d centro_e = _mm256_set1_pd(consulta[COLUNA_ENERGIA]);
+    const __m256d centro_p = _mm256_set1_pd(consulta[COLUNA_PROTEINA]);
+    const __m256d centro_c = _mm256_set1_pd(consulta[COLUNA_CARBOIDRATO]);
+    const __m256d peso_u = _mm256_set1_pd(escala[COLUNA_UMIDADE]);
+    const __m256d peso_e = _mm256_set1_pd(escala[COLUNA_ENERGIA]);
+    const __m256d peso_p = _mm256_set1_pd(escala[COLUNA_PROTEINA]);
+    const __m256d peso_c = _mm256_set1_pd(escala[COLUNA_CARBOIDRATO]);
+    const __m256d maximo = _mm256_set1_pd(limite);
+
+    for (size_t l = inicio_vetor; l < fim_vetor; l += LINHAS_POR_BLOCO) {
+        unsigned bits = (unsigned)(tabela->presenca[l / BITS_POR_PALAVRA] >> (l % BITS_POR_PALAVRA)) & 0xF;
+        if (bits == 0) {
+            continue;
+        }
+
+        __m256d u = _mm256_mul_pd(peso_u, _mm256_sub_pd(_mm256_loadu_pd(umidade + l), centro_u));
+        __m256d e = _mm256_mul_pd(peso_e, _mm256_sub_pd(
+            _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(energia + l))), centro_e));
+        __m256d p = _mm256_mul_pd(peso_p, _mm256_sub_pd(_mm256_loadu_pd(proteina + l), centro_p));
+        __m256d c = _mm256_mul_pd(peso_c, _mm256_sub_pd(_mm256_loadu_pd(carboidrato + l), centro_c));
+        __m256d soma = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(u, u), _mm256_mul_pd(e, e)),
+                                                   _mm256_mul_pd(p, p)),
+                                     _mm256_mul_pd(c, c));
+
+        unsigned perto = (unsigned)_mm256_movemask_pd(_mm256_cmp_pd(soma, maximo, _CMP_LE_OQ)) & bits;
+        if (perto == 0) {
+            continue;
+        }
+        double distancias[LINHAS_POR_BLOCO];
+        _mm256_storeu_pd(distancias, soma);
+        for (; perto != 0; perto &= perto - 1) {
+            int i = __builtin_ctz(perto);
+            candidatos[total].linha = l + (size_t)i;
+            candidatos[total].distancia = distancias[i];
+            total++;
+        }
+    }
+    return total;
+}
+#endif
+
+static NucleoSimilares nucleo_similares = NULL;
+static NivelSimd nivel_nucleo = NIVEL_ESCALAR;
+
+/* Escolhe o nucleo das distancias uma vez; so ha versao vetorizada para AVX2 */
+static void escolher_nucleo(void) {
+    if (nucleo_similares != NULL) {
+        return;
+    }
+    nucleo_similares = candidatos_escalar;
+#ifdef SIMD_X86
+    if (nivel_simd() == NIVEL_AVX2) {
+        nucleo_similares = candidatos_avx2;
+        nivel_nucleo = NIVEL_AVX2;
+    }
+#endif
+}
+
+/* Nome do nivel do nucleo de distancias (AVX2 ou escalar) */
+const char* nivel_simd_similares(void) {
+    escolher_nucleo();
+    return nome_nivel_simd(nivel_nucleo);
+}
+
+/* Pesos de cada nutriente: 1 / desvio padrao, ou 0 se o nutriente for constante */
+void escala_nutrientes(const ResumoCategoria* resumo, double escala[TOTAL_NUTRIENTES]) {
+    for (int c = 0; c < TOTAL_NUTRIENTES; c++) {
+        double desvio = sqrt(resumo->nutrientes[c].variancia);
+        escala[c] = desvio > 0.0 ? 1.0 / desvio : 0.0;
+    }
+}
+
+/* Os k vizinhos de consulta em [inicio, fim), pelo nucleo escolhido, em
+ * lotes alinhados de LINHAS_POR_LOTE linhas: cada lote volta so com as
+ * linhas que ainda cabem no heap e o limite aperta de um lote para o
+ * outro. Com o heap cheio, quase toda linha custa so as contas. */
+size_t vizinhos_forca_bruta(const TabelaAlimentos* tabela, size_t inicio, size_t fim,
+                            const double consulta[TOTAL_NUTRIENTES], const double escala[TOTAL_NUTRIENTES],
+                            size_t excluir, size_t k, Vizinho* saida) {
+    if (k == 0 || inicio >= fim) {
+        return 0;
+    }
+    if (k > fim - inicio) {
+        k = fim - inicio;
+    }
+
+    HeapVizinhos heap;
+    criar_heap(&heap, k);
+    escolher_nucleo();
+
+    Vizinho candidatos[LINHAS_POR_LOTE];
+    for (size_t lote = inicio; lote < fim;) {
+        size_t fim_lote = (lote / LINHAS_POR_LOTE + 1) * LINHAS_POR_LOTE;
+        if (fim_lote > fim) {
+            fim_lote = fim;
+        }
+        size_t achados = nucleo_similares(tabela, lote, fim_lote, consulta, escala, limite_heap(&heap), candidatos);
+        for (size_t i = 0; i < achados; i++) {
+            if (candidatos[i].linha != excluir) {
+                oferecer(&heap, candidatos[i].linha, candidatos[i].distancia);
+            }
+        }
+        lote = fim_lote;
+    }
+    return esvaziar_heap(&heap, saida);
+}
+
+/* Estado de uma busca na arvore k-d */
+typedef struct {
+    const ArvoreKD* arvore;
+    const TabelaAlimentos* tabela;
+    const NoCategoria* categoria;
+    const double* consulta;
+    const double* escala;
+    size_t excluir;
+    HeapVizinhos heap;
+} BuscaVizinhos;
+
+/* Oferece um ponto ao heap se a linha ainda estiver presente, nao for a
+ * excluida e for da categoria procurada */
+static void avaliar_ponto(BuscaVizinhos* busca, const PontoKD* ponto) {
+    size_t linha = ponto->linha;
+    const TabelaAlimentos* tabela = busca->tabela;
+    if (linha == busca->excluir || !linha_presente(tabela, linha)) {
+        return;
+    }
+    if (busca->categoria != NULL && tabela->alimento[linha]->categoria != busca->categoria) {
+        return;
+    }
+
+    double soma = 0.0;
+    for (int d = 0; d < TOTAL_NUTRIENTES; d++) {
+        double t = busca->escala[d] * (ponto->valores[d] - busca->consulta[d]);
+        soma += t * t;
+    }
+    if (soma <= limite_heap(&busca->heap)) {
+        oferecer(&busca->heap, linha, soma);
+    }
+}
+
+/* Visita a subarvore de [inicio, fim): primeiro o lado da consulta, depois
+ * o outro so se o plano de corte estiver a no maximo a distancia do pior
+ * guardado (com igualdade, por causa do desempate pela linha) */
+static void visitar_vizinhos(BuscaVizinhos* busca, size_t inicio, size_t fim) {
+    const ArvoreKD* arvore = busca->arvore;
+    if (fim - inicio <= BALDE_KD) {
+        for (size_t i = inicio; i < fim; i++) {
+            avaliar_ponto(busca, &arvore->pontos[i]);
+        }
+        return;
+    }
+
+    size_t meio = inicio + (fim - inicio) / 2;
+    int dimensao = arvore->dimensao[meio];
+    double diferenca = busca->escala[dimensao] * (busca->consulta[dimensao] - arvore->pontos[meio].valores[dimensao]);
+
+    avaliar_ponto(busca, &arvore->pontos[meio]);
+    if (diferenca <= 0.0) {
+        visitar_vizinhos(busca, inicio, meio);
+        if (diferenca * diferenca <= limite_heap(&busca->heap)) {
+            visitar_vizinhos(busca, meio + 1, fim);
+        }
+    } else {
+        visitar_vizinhos(busca, meio + 1, fim);
+        if (diferenca * diferenca <= limite_heap(&busca->heap)) {
+            visitar_vizinhos(busca, inicio, meio);
+        }
+    }
+}
+
+/* Os k vizinhos de consulta pela arvore k-d, com poda pelo k-esimo */
+size_t vizinhos_arvore_kd(const ArvoreKD* arvore, const TabelaAlimentos* tabela, const NoCategoria* categoria,
+                          const double consulta[TOTAL_NUTRIENTES], const double escala[TOTAL_NUTRIENTES],
+                          size_t excluir, size_t k, Vizinho* saida) {
+    if (k == 0 || arvore->total == 0) {
+        return 0;
+    }
+    if (k > arvore->total) {
+        k = arvore->total;
+    }
+
+    BuscaVizinhos busca;
+    busca.arvore = arvore;
+    busca.tabela = tabela;
+    busca.categoria = categoria;
+    busca.consulta = consulta;
+    busca.escala = escala;
+    busca.excluir = excluir;
+    criar_heap(&busca.heap, k);
+    visitar_vizinhos(&busca, 0, arvore->total);
+    return esvaziar_heap(&busca.heap, saida);
+}
+
+/* Os k alimentos mais parecidos com o de numero dado. A escala sai das
+ * estatisticas mantidas nas categorias (O(categorias)); o caminho e a
+ * forca bruta sobre a particao (ou a tabela) ou a arvore k-d, pelo custo
+ * estimado de cada um (ver FATOR_FORCA_BRUTA). */
+size_t buscar_similares(const BaseDados* base, int numero, const NoCategoria* categoria,
+                        size_t k, Vizinho* saida) {
+    const EntradaNumero* entrada = buscar_indice_numero(&base->numeros, numero);
+    if (entrada == NULL || k == 0) {
+        return 0;
+    }
+
+    const TabelaAlimentos* tabela = &base->tabela;
+    size_t linha = entrada->alimento->linha;
+    double consulta[TOTAL_NUTRIENTES];
+    consulta[COLUNA_UMIDADE] = tabela->umidade[linha];
+    consulta[COLUNA_ENERGIA] = (double)tabela->energia_kcal[linha];
+    consulta[COLUNA_PROTEINA] = tabela->proteina[linha];
+    consulta[COLUNA_CARBOIDRATO] = tabela->carboidrato[linha];
+
+    ResumoCategoria total;
+    memset(&total, 0, sizeof(total));
+    for (const NoCategoria* atual = base->lista_categorias; atual != NULL; atual = atual->proximo) {
+        ResumoCategoria parte;
+        ler_estatisticas_categoria(atual, &parte);
+        combinar_resumos(&total, &parte);
+    }
+    double escala[TOTAL_NUTRIENTES];
+    escala_nutrientes(&total, escala);
+
+    size_t inicio = 0;
+    size_t fim = tabela->total;
+    size_t candidatos = tabela->presentes;
+    if (categoria != NULL) {
+        const ParticaoTabela* particao = particao_categoria(tabela, categoria);
+        inicio = particao->inicio;
+        fim = particao->fim;
+        candidatos = categoria->estatisticas.quantidade;
+    }
+
+    double custo_forca_bruta = (double)candidatos * (double)candidatos;
+    if (custo_forca_bruta <= (double)FATOR_FORCA_BRUTA * (double)k * (double)tabela->presentes) {
+        return vizinhos_forca_bruta(tabela, inicio, fim, consulta, escala, linha, k, saida);
+    }
+    return vizinhos_arvore_kd(&base->nutrientes, tabela, categoria, consulta, escala, linha, k, saida);
+}
@@ -0,0 +1,59 @@
+#ifndef SIMILARES_H
+#define SIMILARES_H
+
+#include "tipos.h"
+#include "agregacao.h"
+
+/* Busca dos alimentos mais parecidos com um alimento dado: os k vizinhos
+ * mais proximos no espaco (umidade, energia, proteina, carboidrato), com
+ * cada nutriente dividido pelo seu desvio padrao para que nenhum domine a
+ * distancia so por causa da unidade. Ha dois caminhos com o mesmo
+ * resultado: forca bruta vetorizada (poucos candidatos) e a arvore k-d
+ * da base (muitos); buscar_similares escolhe entre eles. */
+
+/* Vizinho encontrado: linha da tabela e distancia normalizada ate a consulta */
+typedef struct {
+    size_t linha;
+    double distancia;
+} Vizinho;
+
+/* Linha excluida da busca quando nenhuma deve ser (ver excluir abaixo) */
+#define SEM_EXCLUSAO ((size_t)-1)
+
+/* Escolha do caminho em buscar_similares. Com m candidatos (a categoria,
+ * ou a tabela) e N pontos na arvore, a forca bruta faz m distancias e a
+ * arvore visita da ordem de k * N / m pontos, cada um bem mais caro; a
+ * forca bruta fica com os casos m * m <= FATOR_FORCA_BRUTA * k * N:
+ * tabelas minusculas e categorias pequenas em tabelas grandes (ver make bench) */
+#define FATOR_FORCA_BRUTA 16
+
+/* Nivel do nucleo de distancias em uso: AVX2 ou escalar (ver simd.h) */
+const char* nivel_simd_similares(void);
+
+/* Pesos de cada nutriente a partir de um resumo: 1 / desvio padrao, ou 0
+ * quando o nutriente e constante (ele entao nao conta na distancia) */
+void escala_nutrientes(const ResumoCategoria* resumo, double escala[TOTAL_NUTRIENTES]);
+
+/* Os k vizinhos de consulta entre as linhas presentes de [inicio, fim),
+ * comparando com todas. A linha excluir (ou SEM_EXCLUSAO) fica de fora.
+ * Grava em saida (espaco para k) do mais proximo para o mais distante,
+ * com empates na ordem da tabela, e retorna quantos gravou. */
+size_t vizinhos_forca_bruta(const TabelaAlimentos* tabela, size_t inicio, size_t fim,
+                            const double consulta[TOTAL_NUTRIENTES], const double escala[TOTAL_NUTRIENTES],
+                            size_t excluir, size_t k, Vizinho* saida);
+
+/* O mesmo pela arvore k-d: subarvores que nao podem ter ponto mais perto
+ * que o k-esimo ja achado sao podadas. Com categoria, so conta as linhas
+ * dela; linhas removidas da tabela sao ignoradas. */
+size_t vizinhos_arvore_kd(const ArvoreKD* arvore, const TabelaAlimentos* tabela, const NoCategoria* categoria,
+                          const double consulta[TOTAL_NUTRIENTES], const double escala[TOTAL_NUTRIENTES],
+                          size_t excluir, size_t k, Vizinho* saida);
+
+/* Os k alimentos mais parecidos com o de numero dado (ele mesmo fica de
+ * fora), em uma categoria ou em todas (categoria NULL). A escala vem das
+ * estatisticas de todas as categorias, para que as distancias sejam as
+ * mesmas com e sem filtro. Retorna quantos gravou; 0 se o numero nao existir. */
+size_t buscar_similares(const BaseDados* base, int numero, const NoCategoria* categoria,
+                        size_t k, Vizinho* saida);
+
+#endif
@@ -0,0 +1,183 @@
+#include "tabela.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Quantidade de zeros a direita do primeiro bit 1 (palavra diferente de 0) */
+static unsigned zeros_a_direita(uint64_t palavra) {
+#ifdef __GNUC__
+    return (unsigned)__builtin_ctzll(palavra);
+#else
+    unsigned zeros = 0;
+    while ((palavra & 1) == 0) {
+        palavra >>= 1;
+        zeros++;
+    }
+    return zeros;
+#endif
+}
+
+/* Quantidade de bits 1 de uma palavra */
+static unsigned bits_ligados(uint64_t palavra) {
+#ifdef __GNUC__
+    return (unsigned)__builtin_popcountll(palavra);
+#else
+    unsigned total = 0;
+    while (palavra != 0) {
+        palavra &= palavra - 1;
+        total++;
+    }
+    return total;
+#endif
+}
+
+/* Comparacao para qsort: por descricao; descricoes iguais ficam na ordem do
+ * arquivo (os nos estao em sequencia no vetor de alimentos da base) */
+static int comparar_descricao(const void* a, const void* b) {
+    const NoAlimento* x = *(const NoAlimento* const*)a;
+    const NoAlimento* y = *(const NoAlimento* const*)b;
+    int ordem = strcmp(x->descricao, y->descricao);
+    if (ordem != 0) {
+        return ordem;
+    }
+    return (x > y) - (x < y);
+}
+
+/* Aloca uma coluna zerada (ao menos um elemento, para nunca ser NULL) */
+static void* alocar_coluna(size_t total, size_t tamanho, bool* sucesso) {
+    void* coluna = calloc(total > 0 ? total : 1, tamanho);
+    if (coluna == NULL) {
+        *sucesso = false;
+    }
+    return coluna;
+}
+
+/* Monta a tabela colunar a partir dos nos carregados (cada um ja ligado a
+ * sua categoria): uma particao por categoria da lista, na ordem da lista,
+ * com as linhas ordenadas por descricao. Retorna false se faltar memoria.
+ * As linhas sao distribuidas por contagem (uma passada) e cada particao e
+ * ordenada uma unica vez. */
+bool construir_tabela(TabelaAlimentos* tabela, NoCategoria* lista_categorias,
+                      NoAlimento* alimentos, size_t total_alimentos) {
+    memset(tabela, 0, sizeof(TabelaAlimentos));
+
+    size_t total_particoes = 0;
+    for (NoCategoria* categoria = lista_categorias; categoria != NULL; categoria = categoria->proximo) {
+        categoria->particao = total_particoes++;
+    }
+
+    size_t palavras = (total_alimentos + BITS_POR_PALAVRA - 1) / BITS_POR_PALAVRA;
+    bool sucesso = true;
+    tabela->numero = (int*)alocar_coluna(total_alimentos, sizeof(int), &sucesso);
+    tabela->umidade = (double*)alocar_coluna(total_alimentos, sizeof(double), &sucesso);
+    tabela->energia_kcal = (int*)alocar_coluna(total_alimentos, sizeof(int), &sucesso);
+    tabela->proteina = (double*)alocar_coluna(total_alimentos, sizeof(double), &sucesso);
+    tabela->carboidrato = (double*)alocar_coluna(total_alimentos, sizeof(double), &sucesso);
+    tabela->alimento = (NoAlimento**)alocar_coluna(total_alimentos, sizeof(NoAlimento*), &sucesso);
+    tabela->presenca = (uint64_t*)alocar_coluna(palavras, sizeof(uint64_t), &sucesso);
+    tabela->particoes = (ParticaoTabela*)alocar_coluna(total_particoes, sizeof(ParticaoTabela), &sucesso);
+    if (!sucesso) {
+        fprintf(stderr, "Erro ao alocar memoria para a tabela de alimentos.\n");
+        liberar_tabela(tabela);
+        return false;
+    }
+    tabela->total = total_alimentos;
+    tabela->presentes = total_alimentos;
+    tabela->total_particoes = total_particoes;
+
+    /* Tamanho de cada particao e, por soma acumulada, seu inicio */
+    for (size_t i = 0; i < total_alimentos; i++) {
+        tabela->particoes[alimentos[i].categoria->particao].fim++;
+    }
+    size_t inicio = 0;
+    for (NoCategoria* categoria = lista_categorias; categoria != NULL; categoria = categoria->proximo) {
+        ParticaoTabela* particao = &tabela->particoes[categoria->particao];
+        particao->categoria = categoria;
+        particao->inicio = inicio;
+        inicio += particao->fim;
+        particao->fim = particao->inicio;
+    }
+
+    /* Distribui os nos (na ordem do arquivo) e ordena cada particao */
+    for (size_t i = 0; i < total_alimentos; i++) {
+        ParticaoTabela* particao = &tabela->particoes[alimentos[i].categoria->particao];
+        tabela->alimento[particao->fim++] = &alimentos[i];
+    }
+    for (size_t p = 0; p < total_particoes; p++) {
+        const ParticaoTabela* particao = &tabela->particoes[p];
+        qsort(tabela->alimento + particao->inicio, particao->fim - particao->inicio,
+              sizeof(NoAlimento*), comparar_descricao);
+    }
+
+    for (size_t linha = 0; linha < total_alimentos; linha++) {
+        NoAlimento* alimento = tabela->alimento[linha];
+        alimento->linha = linha;
+        tabela->numero[linha] = alimento->numero;
+        tabela->umidade[linha] = alimento->umidade;
+        tabela->energia_kcal[linha] = alimento->energia_kcal;
+        tabela->proteina[linha] = alimento->proteina;
+        tabela->carboidrato[linha] = alimento->carboidrato;
+    }
+    for (size_t p = 0; p < palavras; p++) {
+        size_t restantes = total_alimentos - p * BITS_POR_PALAVRA;
+        tabela->presenca[p] = restantes >= BITS_POR_PALAVRA ? ~(uint64_t)0 : ((uint64_t)1 << restantes) - 1;
+    }
+    return true;
+}
+
+/* Particao (faixa de linhas) de uma categoria */
+const ParticaoTabela* particao_categoria(const TabelaAlimentos* tabela, const NoCategoria* categoria) {
+    return &tabela->particoes[categoria->particao];
+}
+
+/* Primeira linha presente em [linha, fim), ou fim se nao houver.
+ * Pula de palavra em palavra do mapa de bits: linhas removidas custam
+ * uma palavra a cada 64. */
+size_t proxima_linha(const TabelaAlimentos* tabela, size_t linha, size_t fim) {
+    while (linha < fim) {
+        uint64_t palavra = tabela->presenca[linha / BITS_POR_PALAVRA] >> (linha % BITS_POR_PALAVRA);
+        if (palavra != 0) {
+            linha += zeros_a_direita(palavra);
+            return linha < fim ? linha : fim;
+        }
+        linha = (linha / BITS_POR_PALAVRA + 1) * BITS_POR_PALAVRA;
+    }
+    return fim;
+}
+
+/* Quantidade de linhas presentes em [inicio, fim) */
+size_t contar_linhas(const TabelaAlimentos* tabela, size_t inicio, size_t fim) {
+    size_t total = 0;
+    while (inicio < fim) {
+        size_t deslocamento = inicio % BITS_POR_PALAVRA;
+        size_t bits = BITS_POR_PALAVRA - deslocamento;
+        if (bits > fim - inicio) {
+            bits = fim - inicio;
+        }
+        uint64_t mascara = bits == BITS_POR_PALAVRA ? ~(uint64_t)0 : ((uint64_t)1 << bits) - 1;
+        total += bits_ligados(tabela->presenca[inicio / BITS_POR_PALAVRA] & (mascara << deslocamento));
+        inicio += bits;
+    }
+    return total;
+}
+
+/* Marca uma linha como removida (os dados continuam no vetor) */
+void remover_linha(TabelaAlimentos* tabela, size_t linha) {
+    if (linha_presente(tabela, linha)) {
+        tabela->presenca[linha / BITS_POR_PALAVRA] &= ~((uint64_t)1 << (linha % BITS_POR_PALAVRA));
+        tabela->presentes--;
+    }
+}
+
+/* Libera as colunas da tabela */
+void liberar_tabela(TabelaAlimentos* tabela) {
+    free(tabela->numero);
+    free(tabela->umidade);
+    free(tabela->energia_kcal);
+    free(tabela->proteina);
+    free(tabela->carboidrato);
+    free(tabela->alimento);
+    free(tabela->presenca);
+    free(tabela->particoes);
+    memset(tabela, 0, sizeof(TabelaAlimentos));
+}
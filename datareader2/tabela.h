@@ -0,0 +1,38 @@
+#ifndef TABELA_H
+#define TABELA_H
+
+#include "tipos.h"
+
+/* Bits por palavra dos mapas de bits de linhas (a presenca da tabela e as
+ * selecoes de filtro.h): a linha l e o bit l % 64 da palavra l / 64 */
+#define BITS_POR_PALAVRA 64
+
+/* Indica se a linha esta presente (nao foi removida) */
+static inline bool linha_presente(const TabelaAlimentos* tabela, size_t linha) {
+    return (tabela->presenca[linha / BITS_POR_PALAVRA] >> (linha % BITS_POR_PALAVRA) & 1) != 0;
+}
+
+/* Monta a tabela colunar a partir dos nos carregados (cada um ja ligado a
+ * sua categoria): uma particao por categoria da lista, na ordem da lista,
+ * com as linhas ordenadas por descricao. Retorna false se faltar memoria. */
+bool construir_tabela(TabelaAlimentos* tabela, NoCategoria* lista_categorias,
+                      NoAlimento* alimentos, size_t total_alimentos);
+
+/* Particao (faixa de linhas) de uma categoria */
+const ParticaoTabela* particao_categoria(const TabelaAlimentos* tabela, const NoCategoria* categoria);
+
+/* Primeira linha presente em [linha, fim), ou fim se nao houver.
+ * Percorre uma faixa com:
+ *   for (l = proxima_linha(t, inicio, fim); l < fim; l = proxima_linha(t, l + 1, fim)) */
+size_t proxima_linha(const TabelaAlimentos* tabela, size_t linha, size_t fim);
+
+/* Quantidade de linhas presentes em [inicio, fim) */
+size_t contar_linhas(const TabelaAlimentos* tabela, size_t inicio, size_t fim);
+
+/* Marca uma linha como removida (os dados continuam no vetor) */
+void remover_linha(TabelaAlimentos* tabela, size_t linha);
+
+/* Libera as colunas da tabela */
+void liberar_tabela(TabelaAlimentos* tabela);
+
+#endif
@@ -0,0 +1,18 @@
+/* Gerado por gerar_tabela_categorias a partir de categorias.def.
+ * Nao editar: use 'make tabela_categorias.h'. */
+#ifndef TABELA_CATEGORIAS_H
+#define TABELA_CATEGORIAS_H
+
+#include <stdint.h>
+
+#define HASH_CATEGORIAS_SEMENTE 0x9dd8398du
+#define HASH_CATEGORIAS_BITS 5
+#define HASH_CATEGORIAS_TOTAL_NOMES 19
+
+/* Posicao do hash -> indice do nome em categorias.def (-1: vazia) */
+static const int8_t TABELA_HASH_CATEGORIAS[32] = {
+    15, 4, 16, -1, -1, -1, -1, -1, -1, -1, 14, 5, -1, 13, 8, 7,
+    2, 18, -1, 10, 11, -1, 17, -1, 0, 12, 3, -1, -1, 6, 9, 1
+};
+
+#endif
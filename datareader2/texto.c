@@ -0,0 +1,117 @@
+#include "texto.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CAPACIDADE_INICIAL_POOL 4096
+#define CAPACIDADE_INICIAL_TABELA 256
+
+/* Hash FNV-1a dos bytes de um texto */
+static uint32_t hash_texto(const char* texto, size_t tamanho) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < tamanho; i++) {
+        hash = (hash ^ (unsigned char)texto[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/* Le o tamanho guardado antes do texto */
+static uint32_t tamanho_no_pool(const PoolTextos* pool, uint32_t offset) {
+    uint32_t tamanho;
+    memcpy(&tamanho, pool->dados + offset - sizeof(uint32_t), sizeof(uint32_t));
+    return tamanho;
+}
+
+/* Dobra a tabela de hash e reinsere os textos existentes */
+static void crescer_tabela(PoolTextos* pool) {
+    size_t nova_capacidade = pool->capacidade_tabela > 0 ? pool->capacidade_tabela * 2 : CAPACIDADE_INICIAL_TABELA;
+    uint32_t* nova = (uint32_t*)calloc(nova_capacidade, sizeof(uint32_t));
+    if (nova == NULL) {
+        fprintf(stderr, "Erro ao alocar memoria para o pool de textos.\n");
+        exit(1);
+    }
+
+    for (size_t i = 0; i < pool->capacidade_tabela; i++) {
+        uint32_t entrada = pool->tabela[i];
+        if (entrada == 0) {
+            continue;
+        }
+        uint32_t offset = entrada - 1;
+        size_t posicao = hash_texto(pool->dados + offset, tamanho_no_pool(pool, offset)) & (nova_capacidade - 1);
+        while (nova[posicao] != 0) {
+            posicao = (posicao + 1) & (nova_capacidade - 1);
+        }
+        nova[posicao] = entrada;
+    }
+
+    free(pool->tabela);
+    pool->tabela = nova;
+    pool->capacidade_tabela = nova_capacidade;
+}
+
+/* Inicializa um pool vazio */
+void inicializar_pool_textos(PoolTextos* pool) {
+    memset(pool, 0, sizeof(PoolTextos));
+}
+
+/* Interna um texto e retorna sua referencia (textos iguais compartilham a mesma) */
+RefTexto internar_texto(PoolTextos* pool, const char* texto, size_t tamanho) {
+    if ((pool->total_textos + 1) * 10 > pool->capacidade_tabela * 7) {
+        crescer_tabela(pool);
+    }
+
+    uint32_t hash = hash_texto(texto, tamanho);
+    size_t posicao = hash & (pool->capacidade_tabela - 1);
+    while (pool->tabela[posicao] != 0) {
+        uint32_t offset = pool->tabela[posicao] - 1;
+        if (tamanho_no_pool(pool, offset) == tamanho && memcmp(pool->dados + offset, texto, tamanho) == 0) {
+            RefTexto ref = { offset, (uint32_t)tamanho };
+            return ref;
+        }
+        posicao = (posicao + 1) & (pool->capacidade_tabela - 1);
+    }
+
+    size_t necessario = pool->tamanho + sizeof(uint32_t) + tamanho + 1;
+    if (necessario >= UINT32_MAX) {
+        fprintf(stderr, "Pool de textos excedeu o tamanho maximo.\n");
+        exit(1);
+    }
+    if (necessario > pool->capacidade) {
+        size_t nova_capacidade = pool->capacidade > 0 ? pool->capacidade : CAPACIDADE_INICIAL_POOL;
+        while (nova_capacidade < necessario) {
+            nova_capacidade *= 2;
+        }
+        char* novos_dados = (char*)realloc(pool->dados, nova_capacidade);
+        if (novos_dados == NULL) {
+            fprintf(stderr, "Erro ao alocar memoria para o pool de textos.\n");
+            exit(1);
+        }
+        pool->dados = novos_dados;
+        pool->capacidade = nova_capacidade;
+    }
+
+    uint32_t tamanho32 = (uint32_t)tamanho;
+    memcpy(pool->dados + pool->tamanho, &tamanho32, sizeof(uint32_t));
+    uint32_t offset = (uint32_t)(pool->tamanho + sizeof(uint32_t));
+    memcpy(pool->dados + offset, texto, tamanho);
+    pool->dados[offset + tamanho] = '\0';
+    pool->tamanho = necessario;
+
+    pool->tabela[posicao] = offset + 1;
+    pool->total_textos++;
+
+    RefTexto ref = { offset, tamanho32 };
+    return ref;
+}
+
+/* Retorna o texto apontado por uma referencia */
+const char* texto_do_pool(const PoolTextos* pool, RefTexto ref) {
+    return pool->dados + ref.offset;
+}
+
+/* Libera a memoria do pool */
+void liberar_pool_textos(PoolTextos* pool) {
+    free(pool->dados);
+    free(pool->tabela);
+    memset(pool, 0, sizeof(PoolTextos));
+}
@@ -0,0 +1,31 @@
+#ifndef TEXTO_H
+#define TEXTO_H
+
+#include "tipos.h"
+
+/* Pool de textos internados: cada texto distinto e guardado uma unica vez,
+ * precedido de seu tamanho (uint32_t) e seguido de '\0'. As referencias
+ * (RefTexto) apontam para o primeiro byte do texto e continuam validas
+ * mesmo quando o pool cresce. */
+typedef struct {
+    char* dados;
+    size_t tamanho;
+    size_t capacidade;
+    uint32_t* tabela;          /* offset + 1 de cada texto; 0 = posicao livre */
+    size_t capacidade_tabela;
+    size_t total_textos;
+} PoolTextos;
+
+/* Inicializa um pool vazio */
+void inicializar_pool_textos(PoolTextos* pool);
+
+/* Interna um texto e retorna sua referencia (textos iguais compartilham a mesma) */
+RefTexto internar_texto(PoolTextos* pool, const char* texto, size_t tamanho);
+
+/* Retorna o texto apontado por uma referencia */
+const char* texto_do_pool(const PoolTextos* pool, RefTexto ref);
+
+/* Libera a memoria do pool */
+void liberar_pool_textos(PoolTextos* pool);
+
+#endif
@@ -2,29 +2,34 @@
 #define TIPOS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #define MAX_DESCRICAO 100
 #define MAX_CATEGORIA 50
+#define MAX_INDICES 12
 
-/* Enumerado para as 15 categorias de alimentos conforme especificacao */
+/* Enumerado para as 15 categorias de alimentos conforme especificacao
+ * (gerado de categorias.def); CATEGORIA_INVALIDA marca nome desconhecido */
 typedef enum {
-    ALIMENTOS_PREPARADOS,
-    BEBIDAS,
-    CARNES_E_DERIVADOS,
-    CEREAIS_E_DERIVADOS,
-    FRUTAS_E_DERIVADOS,
-    GORDURAS_E_OLEOS,
-    LEGUMINOSAS_E_DERIVADOS,
-    LEITE_E_DERIVADOS,
-    MISCELANEAS,
-    NOZES_E_SEMENTES,
-    OUTROS_ALIMENTOS_INDUSTRIALIZADOS,
-    OVOS_E_DERIVADOS,
-    PESCADOS_E_FRUTOS_DO_MAR,
-    PRODUTOS_ACUCARADOS,
-    VERDURAS_HORTALICAS_E_DERIVADOS
+#define CATEGORIA(tipo, nome) tipo,
+#define SINONIMO(tipo, nome)
+#include "categorias.def"
+#undef CATEGORIA
+#undef SINONIMO
+    CATEGORIA_INVALIDA
 } TipoCategoria;
 
+/* Quantidade de categorias conhecidas (tamanho de vetores indexados por TipoCategoria) */
+#define TOTAL_CATEGORIAS CATEGORIA_INVALIDA
+
+/* Referencia a um texto de um pool (ver texto.h): posicao e tamanho em bytes.
+ * O texto e precedido pelo seu tamanho e seguido de '\0'. */
+typedef struct {
+    uint32_t offset;
+    uint32_t tamanho;
+} RefTexto;
+
 /* Estrutura para armazenar alimento lido do arquivo binario */
 typedef struct {
     int numero;
@@ -36,33 +41,193 @@ typedef struct {
     char categoria[MAX_CATEGORIA];
 } AlimentoArquivo;
 
-/* No de alimento em lista ligada */
+/* Colunas numericas (nutrientes) da tabela colunar */
+typedef enum {
+    COLUNA_UMIDADE,
+    COLUNA_ENERGIA,
+    COLUNA_PROTEINA,
+    COLUNA_CARBOIDRATO
+} ColunaNutriente;
+
+/* Quantidade de colunas de nutrientes (tamanho de vetores indexados por ColunaNutriente) */
+#define TOTAL_NUTRIENTES (COLUNA_CARBOIDRATO + 1)
+
+/* No de alimento: o registro completo de uma linha da tabela colunar,
+ * apontado pelas arvores e pelo indice por numero.
+ * A descricao aponta para dentro do arquivo mapeado em memoria (nao e copiada):
+ * no formato atual, para o pool de textos do arquivo. */
 typedef struct NoAlimento {
     int numero;
-    char descricao[MAX_DESCRICAO];
+    uint32_t tamanho_descricao;
+    const char* descricao;
     double umidade;
     int energia_kcal;
     double proteina;
     double carboidrato;
-    struct NoAlimento* proximo;
+    struct NoCategoria* categoria;
+    size_t linha;                 /* posicao na tabela colunar */
 } NoAlimento;
 
-/* No de categoria em lista ligada */
+/* Somas correntes de um nutriente em um grupo de alimentos. soma e
+ * soma_quadrados usam os valores menos referencia (um valor do grupo),
+ * o que mantem a variancia estavel ao descontar alimentos. */
+typedef struct {
+    double referencia;
+    double soma;
+    double soma_quadrados;
+    double minimo;
+    double maximo;
+    size_t no_minimo;             /* alimentos com o valor minimo (0 = nao contados) */
+    size_t no_maximo;             /* alimentos com o valor maximo (0 = nao contados) */
+} SomasNutriente;
+
+/* Estatisticas mantidas em cada categoria e atualizadas a cada remocao */
+typedef struct {
+    size_t quantidade;
+    SomasNutriente nutrientes[TOTAL_NUTRIENTES];
+} EstatisticasCategoria;
+
+/* No de categoria em lista ligada; seus alimentos sao a particao de
+ * mesmo indice na tabela colunar */
 typedef struct NoCategoria {
     char nome[MAX_CATEGORIA];
     TipoCategoria tipo;
-    NoAlimento* lista_alimentos;
-    struct NoArvore* arvore_energia;
-    struct NoArvore* arvore_proteina;
+    size_t particao;
+    EstatisticasCategoria estatisticas;   /* ver agregacao.h */
+    struct NoArvore* indices[MAX_INDICES];  /* arvore de cada indice por categoria (ver indices.h) */
     struct NoCategoria* proximo;
 } NoCategoria;
 
-/* No de arvore binaria de indexacao */
+/* No de arvore binaria de indexacao (AVL: altura usada no balanceamento;
+ * tamanho = nos da subarvore, para consultas de posto e k-esimo) */
 typedef struct NoArvore {
     double chave;
     NoAlimento* alimento;
     struct NoArvore* esquerda;
     struct NoArvore* direita;
+    int altura;
+    size_t tamanho;
 } NoArvore;
 
+/* Arquivo mapeado em memoria (somente leitura) */
+typedef struct {
+    const unsigned char* dados;
+    size_t tamanho;
+    void* arquivo;        /* handles usados apenas no Windows */
+    void* mapeamento;
+} MapaArquivo;
+
+/* Arena de alocacao (ver arena.h): blocos contiguos liberados de uma vez */
+typedef struct {
+    struct BlocoArena* bloco;      /* bloco atual; cada um aponta para o anterior */
+    size_t proxima_capacidade;
+} Arena;
+
+/* Registro de categorias (ver registro.h): busca por nome em tabela hash
+ * com enderecamento aberto */
+typedef struct {
+    NoCategoria** tabela;          /* NULL = posicao livre */
+    size_t capacidade;             /* potencia de 2 */
+    size_t total;
+} RegistroCategorias;
+
+/* Entrada do indice por numero: o alimento e a categoria que o contem */
+typedef struct {
+    NoAlimento* alimento;
+    NoCategoria* categoria;
+} EntradaNumero;
+
+/* Indice global de alimentos por numero (hash com enderecamento aberto;
+ * posicao vazia tem alimento NULL) */
+typedef struct {
+    EntradaNumero* tabela;
+    size_t capacidade;
+    size_t total;
+} IndiceNumero;
+
+/* Faixa de linhas [inicio, fim) de uma categoria na tabela colunar.
+ * categoria fica NULL quando a categoria e removida. */
+typedef struct {
+    NoCategoria* categoria;
+    size_t inicio;
+    size_t fim;
+} ParticaoTabela;
+
+/* Tabela colunar dos alimentos: um vetor denso por campo numerico, o no de
+ * cada linha e um mapa de bits das linhas presentes (removidas tem bit 0).
+ * As linhas de cada categoria sao contiguas e ordenadas por descricao. */
+typedef struct {
+    size_t total;                 /* linhas, inclusive as removidas */
+    size_t presentes;
+    int* numero;
+    double* umidade;
+    int* energia_kcal;
+    double* proteina;
+    double* carboidrato;
+    NoAlimento** alimento;
+    uint64_t* presenca;
+    ParticaoTabela* particoes;
+    size_t total_particoes;
+} TabelaAlimentos;
+
+/* Ponto da arvore k-d: os nutrientes de uma linha da tabela, indexados
+ * por ColunaNutriente */
+typedef struct {
+    double valores[TOTAL_NUTRIENTES];
+    size_t linha;
+} PontoKD;
+
+/* Arvore k-d sobre os nutrientes (ver arvore_kd.h), implicita: o no de
+ * uma faixa [inicio, fim) de pontos e o ponto do meio, com a dimensao de
+ * corte em dimensao[meio]; as metades da faixa sao as subarvores */
+typedef struct {
+    PontoKD* pontos;
+    unsigned char* dimensao;
+    size_t total;
+} ArvoreKD;
+
+/* Valor de uma linha da tabela: uma coluna ou uma expressao sobre elas */
+typedef double (*MetricaLinha)(const TabelaAlimentos* tabela, size_t linha);
+
+/* Escopo de um indice secundario: uma arvore por categoria ou uma so
+ * arvore com os alimentos de todas */
+typedef enum {
+    ESCOPO_CATEGORIA,
+    ESCOPO_GLOBAL
+} EscopoIndice;
+
+/* Definicao de um indice secundario: a chave de cada alimento e a metrica
+ * da sua linha */
+typedef struct {
+    const char* nome;
+    const char* unidade;
+    MetricaLinha chave;
+    EscopoIndice escopo;
+} DefinicaoIndice;
+
+/* Registro dos indices secundarios da base (ver indices.h). O numero do
+ * indice e a posicao em definicoes e nos vetores de arvores. */
+typedef struct {
+    DefinicaoIndice definicoes[MAX_INDICES];
+    size_t total;
+    struct NoArvore* globais[MAX_INDICES];   /* arvores dos indices globais */
+} RegistroIndices;
+
+/* Base de dados carregada: dona do mapeamento, da arena onde ficam todos
+ * os nos (categorias, alimentos e arvores), da tabela colunar, do registro
+ * de categorias, do indice de alimentos por numero, dos indices secundarios
+ * e da arvore k-d dos nutrientes */
+typedef struct {
+    NoCategoria* lista_categorias;
+    NoAlimento* alimentos;
+    size_t total_alimentos;
+    MapaArquivo mapa;
+    Arena arena;
+    RegistroCategorias categorias;
+    IndiceNumero numeros;
+    TabelaAlimentos tabela;
+    RegistroIndices indices;
+    ArvoreKD nutrientes;
+} BaseDados;
+
 #endif
@@ -3,7 +3,9 @@
 
 #include "tipos.h"
 
-/* Converte string de categoria para o tipo enumerado */
+/* Converte string de categoria para o tipo enumerado em tempo constante
+ * (hash perfeito de tabela_categorias.h); nomes desconhecidos viram
+ * CATEGORIA_INVALIDA */
 TipoCategoria string_para_categoria(const char* nome_categoria);
 
 /* Converte tipo enumerado para string de categoria */